@@ -0,0 +1,327 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_BLOOMFILTER_HPP__
+#define __VSQLITE3_BLOOMFILTER_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <array>
+#include <span>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	template <typename Key, typename Hash = std::hash<Key>>
+	class BloomFilter {
+
+	public:
+		BloomFilter(const std::size_t expectedKeys, const double falsePositiveRate = 0.01);
+
+		auto Add(const Key& key) -> void;
+		auto MightContain(const Key& key) const -> bool;
+		auto Clear(void) -> void;
+
+		auto Count(void) const -> std::size_t;
+		auto Capacity(void) const -> std::size_t;
+		auto TargetFalsePositiveRate(void) const -> double;
+		auto EstimatedFalsePositiveRate(void) const -> double;
+		auto IsSaturated(void) const -> bool;
+
+	private:
+		using Block = std::array<std::uint64_t, 8>;
+
+		std::vector<Block> m_blocks;
+		std::size_t m_hashes;
+		std::size_t m_capacity;
+		std::size_t m_count;
+		double m_rate;
+
+		static auto Mix(std::uint64_t value) -> std::uint64_t;
+
+	};
+
+	template <typename Key, typename Hash>
+	inline BloomFilter<Key, Hash>::BloomFilter(const std::size_t expectedKeys, const double falsePositiveRate) {
+
+		if ((falsePositiveRate <= 0.0) || (falsePositiveRate >= 1.0))
+			throw std::invalid_argument("'falsePositiveRate': Rate must be between 0 and 1.");
+
+		const double ln2 = std::log(2.0);
+		const std::size_t keys = std::max<std::size_t>(expectedKeys, 1);
+		const double bits = std::ceil(-static_cast<double>(keys) * std::log(falsePositiveRate) / (ln2 * ln2));
+
+		this->m_blocks.resize(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(bits / 512.0))));
+		this->m_hashes = std::clamp<std::size_t>(static_cast<std::size_t>(std::round((bits / keys) * ln2)), 1, 16);
+		this->m_capacity = keys;
+		this->m_count = 0;
+		this->m_rate = falsePositiveRate;
+
+		this->Clear();
+
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::Add(const Key& key) -> void {
+
+		const std::uint64_t hash = BloomFilter::Mix(static_cast<std::uint64_t>(Hash { }(key)));
+		Block& block = this->m_blocks[hash % this->m_blocks.size()];
+
+		std::uint64_t probe = BloomFilter::Mix(hash);
+		for (std::size_t i = 0; i < this->m_hashes; ++i) {
+			const std::uint32_t bit = static_cast<std::uint32_t>(probe & 511);
+			block[bit >> 6] |= (std::uint64_t { 1 } << (bit & 63));
+			probe = ((probe >> 9) | (probe << 55)) + hash;
+		}
+
+		++this->m_count;
+
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::MightContain(const Key& key) const -> bool {
+
+		const std::uint64_t hash = BloomFilter::Mix(static_cast<std::uint64_t>(Hash { }(key)));
+		const Block& block = this->m_blocks[hash % this->m_blocks.size()];
+
+		std::uint64_t probe = BloomFilter::Mix(hash);
+		for (std::size_t i = 0; i < this->m_hashes; ++i) {
+			const std::uint32_t bit = static_cast<std::uint32_t>(probe & 511);
+			if ((block[bit >> 6] & (std::uint64_t { 1 } << (bit & 63))) == 0) return false;
+			probe = ((probe >> 9) | (probe << 55)) + hash;
+		}
+
+		return true;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::Clear() -> void {
+		std::fill(this->m_blocks.begin(), this->m_blocks.end(), Block { });
+		this->m_count = 0;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::Count() const -> std::size_t {
+		return this->m_count;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::Capacity() const -> std::size_t {
+		return this->m_capacity;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::TargetFalsePositiveRate() const -> double {
+		return this->m_rate;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::EstimatedFalsePositiveRate() const -> double {
+		const double bits = (static_cast<double>(this->m_blocks.size()) * 512.0);
+		const double k = static_cast<double>(this->m_hashes);
+		return std::pow((1.0 - std::exp(-k * static_cast<double>(this->m_count) / bits)), k);
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::IsSaturated() const -> bool {
+		return (this->EstimatedFalsePositiveRate() > (2.0 * this->m_rate));
+	}
+
+	template <typename Key, typename Hash>
+	inline auto BloomFilter<Key, Hash>::Mix(std::uint64_t value) -> std::uint64_t {
+		value += 0x9E3779B97F4A7C15ull;
+		value = ((value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull);
+		value = ((value ^ (value >> 27)) * 0x94D049BB133111EBull);
+		return (value ^ (value >> 31));
+	}
+
+	// Rows inserted through this connection are added as their commits are dispatched. Commits by
+	// other connections are not seen by MightContain(), which only probes the filter; call Refresh()
+	// once per batch or transaction to check PRAGMA data_version and rebuild if needed. Inserts in
+	// this connection's own open transaction are not visible until it commits, so the filter may
+	// report them as absent until then. WITHOUT ROWID tables are rejected: the update hook does not
+	// report changes to them.
+
+	template <typename Key, typename Hash = std::hash<Key>>
+	class KeyFilter {
+
+	public:
+		KeyFilter(Database& db, const std::string_view table, const std::optional<std::string_view> column = std::nullopt, const double falsePositiveRate = 0.01);
+		KeyFilter(const KeyFilter&) = delete;
+		KeyFilter(KeyFilter&&) = delete;
+		~KeyFilter(void);
+
+		auto operator= (const KeyFilter&) -> KeyFilter& = delete;
+		auto operator= (KeyFilter&&) -> KeyFilter& = delete;
+
+		auto MightContain(const Key& key) -> bool;
+		auto RecordFalsePositive(void) -> void;
+		auto Refresh(void) -> bool;
+
+		auto MeasuredFalsePositiveRate(void) const -> double;
+		auto EstimatedFalsePositiveRate(void) const -> double;
+
+		auto Rebuild(void) -> void;
+
+	private:
+		Database* m_pDb;
+		std::string m_table;
+		std::optional<std::string> m_column;
+		double m_rate;
+
+		BloomFilter<Key, Hash> m_filter;
+		std::optional<Statement> m_lookup;
+		DataVersionWatcher m_dataVersion;
+		std::uint64_t m_subscription;
+		bool m_needsRebuild;
+
+		std::uint64_t m_negatives;
+		std::uint64_t m_falsePositives;
+
+		auto OnChanges(const std::span<const ChangeEvent> events) -> void;
+
+	};
+
+	template <typename Key, typename Hash>
+	inline KeyFilter<Key, Hash>::KeyFilter(Database& db, const std::string_view table, const std::optional<std::string_view> column, const double falsePositiveRate)
+		: m_pDb(&db), m_table(table), m_column(column), m_rate(falsePositiveRate), m_filter(1, falsePositiveRate),
+		  m_dataVersion(db), m_subscription(0), m_needsRebuild(false), m_negatives(0), m_falsePositives(0) {
+
+		if (!this->m_column.has_value() && !std::is_integral_v<Key>)
+			throw std::invalid_argument("'column': Rowid filters require an integral key type.");
+
+		std::int32_t withoutRowid = 0;
+		Statement info = { db, "SELECT EXISTS (SELECT 1 FROM pragma_table_list(?) WHERE wr != 0);" };
+		info.Bind(this->m_table);
+		info.Fetch(withoutRowid);
+
+		if (withoutRowid != 0)
+			throw std::invalid_argument("'table': WITHOUT ROWID tables are not supported.");
+
+		if (this->m_column.has_value())
+			this->m_lookup.emplace(db, ("SELECT " + QuoteIdentifier(this->m_column.value()) + " FROM " + QuoteIdentifier(this->m_table) + " WHERE rowid = ?;"));
+
+		this->Rebuild();
+
+		this->m_subscription = db.Subscribe(this->m_table, std::nullopt, [this](const std::span<const ChangeEvent> events) {
+			this->OnChanges(events);
+		});
+
+	}
+
+	template <typename Key, typename Hash>
+	inline KeyFilter<Key, Hash>::~KeyFilter() {
+		this->m_pDb->Unsubscribe(this->m_subscription);
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::MightContain(const Key& key) -> bool {
+
+		if (this->m_needsRebuild)
+			this->Rebuild();
+
+		if (this->m_filter.MightContain(key)) return true;
+
+		++this->m_negatives;
+
+		return false;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::RecordFalsePositive() -> void {
+
+		++this->m_falsePositives;
+
+		const std::uint64_t samples = (this->m_negatives + this->m_falsePositives);
+		if ((samples >= 1024) && (this->MeasuredFalsePositiveRate() > (2.0 * this->m_rate)))
+			this->m_needsRebuild = true;
+
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::Refresh() -> bool {
+
+		this->m_pDb->DispatchChanges();
+		if (!this->m_dataVersion.HasChanged() && !this->m_needsRebuild) return false;
+
+		this->Rebuild();
+
+		return true;
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::MeasuredFalsePositiveRate() const -> double {
+		const std::uint64_t samples = (this->m_negatives + this->m_falsePositives);
+		return ((samples == 0) ? 0.0 : (static_cast<double>(this->m_falsePositives) / static_cast<double>(samples)));
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::EstimatedFalsePositiveRate() const -> double {
+		return this->m_filter.EstimatedFalsePositiveRate();
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::Rebuild() -> void {
+
+		const std::string table = QuoteIdentifier(this->m_table);
+		const std::string column = (this->m_column.has_value() ? QuoteIdentifier(this->m_column.value()) : "rowid");
+
+		std::int64_t rows = 0;
+		Statement count = { *this->m_pDb, ("SELECT count(*) FROM " + table + ";") };
+		count.Fetch(rows);
+
+		BloomFilter<Key, Hash> filter = { std::max<std::size_t>((static_cast<std::size_t>(rows) * 2), 1024), this->m_rate };
+
+		Statement scan = { *this->m_pDb, ("SELECT " + column + " FROM " + table + ";") };
+		Key key { };
+		while (scan.Fetch(key))
+			filter.Add(key);
+
+		this->m_filter = std::move(filter);
+		this->m_needsRebuild = false;
+		this->m_negatives = 0;
+		this->m_falsePositives = 0;
+
+	}
+
+	template <typename Key, typename Hash>
+	inline auto KeyFilter<Key, Hash>::OnChanges(const std::span<const ChangeEvent> events) -> void {
+
+		for (const ChangeEvent& event : events) {
+
+			if (event.operation == ChangeOperation::Delete) continue;
+
+			if (!this->m_lookup.has_value()) {
+				if constexpr (std::is_integral_v<Key>) this->m_filter.Add(static_cast<Key>(event.rowid));
+				continue;
+			}
+
+			Key key { };
+			this->m_lookup->Reset();
+			this->m_lookup->Bind(event.rowid);
+			if (this->m_lookup->Fetch(key)) this->m_filter.Add(key);
+			this->m_lookup->Reset();
+
+		}
+
+		if (this->m_filter.IsSaturated())
+			this->m_needsRebuild = true;
+
+	}
+
+}
+
+#endif // __VSQLITE3_BLOOMFILTER_HPP__
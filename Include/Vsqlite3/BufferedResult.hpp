@@ -0,0 +1,271 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_BUFFEREDRESULT_HPP__
+#define __VSQLITE3_BUFFEREDRESULT_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/SpillCodec.hpp>
+#include <Vsqlite3/MappedFile.hpp>
+
+#include <string>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <memory>
+#include <filesystem>
+#include <random>
+#include <system_error>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Vsqlite3 {
+
+	template <typename... Columns>
+	class BufferedResult {
+
+	public:
+		using Row = std::tuple<Columns...>;
+
+		BufferedResult(Statement& stmt, const std::size_t memoryBudget = (64 * 1024 * 1024));
+		BufferedResult(const BufferedResult&) = delete;
+		BufferedResult(BufferedResult&& other) noexcept;
+		~BufferedResult(void);
+
+		auto operator= (const BufferedResult&) -> BufferedResult& = delete;
+
+		auto Fetch(Columns&... values) -> bool;
+		auto Rewind(void) -> void;
+
+		auto Rows(void) const -> std::uint64_t;
+		auto Bytes(void) const -> std::uint64_t;
+		auto IsSpilled(void) const -> bool;
+
+	private:
+		using File = std::unique_ptr<std::FILE, decltype(&std::fclose)>;
+
+		std::string m_buffer;
+		std::optional<MappedFile> m_file;
+		std::filesystem::path m_path;
+		std::uint64_t m_rows;
+		std::size_t m_offset;
+
+		auto CreateSpillFile(void) -> File;
+		auto WriteBuffer(std::FILE* const pFile) -> void;
+		auto RemoveSpillFile(void) noexcept -> void;
+
+		auto Data(void) const -> const char*;
+		auto Size(void) const -> std::size_t;
+
+	};
+
+	template <typename... Columns>
+	inline BufferedResult<Columns...>::BufferedResult(Statement& stmt, const std::size_t memoryBudget) : m_rows(0), m_offset(0) {
+
+		static_assert((sizeof...(Columns) > 0), "At least one column type must be specified.");
+		static_assert((Spillable<Columns> && ...), "Every column type must have a SpillCodec specialization.");
+
+		if (memoryBudget == 0)
+			throw std::invalid_argument("'memoryBudget': Memory budget cannot be zero.");
+
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+		if (sqlite3_column_count(pStmt) != static_cast<int>(sizeof...(Columns)))
+			throw std::invalid_argument("'stmt': Column count does not match the column types.");
+
+		File file = { nullptr, &std::fclose };
+		Row row = { };
+
+		try {
+
+			// Rows are decoded through the regular bindings and re-encoded with SpillCodec. Once the
+			// encoded rows outgrow the budget, the buffer becomes a write-behind buffer for a temporary
+			// file, so memory use stays bounded no matter how large the result is.
+
+			stmt.Step();
+			while (sqlite3_data_count(pStmt) > 0) {
+
+				[&]<std::size_t... I>(std::index_sequence<I...>) {
+					(Binding<Columns>::Column(pStmt, static_cast<int>(I), std::get<I>(row)), ...);
+				}(std::index_sequence_for<Columns...> { });
+
+				std::apply([this](const Columns&... values) { (SpillCodec<Columns>::Encode(this->m_buffer, values), ...); }, row);
+				++this->m_rows;
+
+				if (this->m_buffer.size() > memoryBudget) {
+					if (file == nullptr) file = this->CreateSpillFile();
+					this->WriteBuffer(file.get());
+				}
+
+				stmt.Step();
+			}
+
+			// The statement is reset here so its read transaction ends before the caller starts
+			// consuming the rows.
+
+			stmt.Reset();
+
+			if (file != nullptr) {
+
+				this->WriteBuffer(file.get());
+				std::string().swap(this->m_buffer);
+
+				if (std::fclose(file.release()) != 0)
+					throw std::system_error(errno, std::generic_category(), "fclose");
+
+				this->m_file.emplace(this->m_path);
+
+#if !defined(_WIN32)
+				// The mapping keeps the data reachable; unlinking right away leaves nothing behind
+				// if the process dies.
+				this->RemoveSpillFile();
+#endif
+
+			}
+
+		}
+		catch (...) {
+			sqlite3_reset(pStmt);
+			file.reset();
+			this->m_file.reset();
+			this->RemoveSpillFile();
+			throw;
+		}
+
+	}
+
+	template <typename... Columns>
+	inline BufferedResult<Columns...>::BufferedResult(BufferedResult&& other) noexcept
+		: m_buffer(std::move(other.m_buffer)), m_file(std::exchange(other.m_file, std::nullopt)), m_path(std::exchange(other.m_path, { })),
+		m_rows(std::exchange(other.m_rows, 0)), m_offset(std::exchange(other.m_offset, 0)) { }
+
+	template <typename... Columns>
+	inline BufferedResult<Columns...>::~BufferedResult() {
+		this->m_file.reset();
+		this->RemoveSpillFile();
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Fetch(Columns&... values) -> bool {
+
+		if (this->m_offset >= this->Size()) return false;
+
+		const char* const pData = this->Data();
+		const char* in = (pData + this->m_offset);
+
+		(SpillCodec<Columns>::Decode(in, values), ...);
+		this->m_offset = static_cast<std::size_t>(in - pData);
+
+		return true;
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Rewind() -> void {
+		this->m_offset = 0;
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Rows() const -> std::uint64_t {
+		return this->m_rows;
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Bytes() const -> std::uint64_t {
+		return this->Size();
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::IsSpilled() const -> bool {
+		return this->m_file.has_value();
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::CreateSpillFile() -> File {
+
+		std::random_device device = { };
+		const std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+		for (int attempt = 0; attempt < 16; ++attempt) {
+
+			const std::uint64_t id = ((static_cast<std::uint64_t>(device()) << 32) | device());
+
+			char name[32] = { };
+			std::snprintf(name, sizeof(name), "vsqlite3-%016llx.tmp", static_cast<unsigned long long>(id));
+
+			this->m_path = (directory / name);
+
+#if defined(_WIN32)
+			File file = { std::fopen(this->m_path.string().c_str(), "wbx"), &std::fclose };
+			if (file != nullptr) return file;
+#else
+			// Created as 0600 regardless of the umask, so other users cannot read the spilled rows.
+
+			const int descriptor = ::open(this->m_path.c_str(), (O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC), 0600);
+			if (descriptor >= 0) {
+
+				File file = { fdopen(descriptor, "wb"), &std::fclose };
+				if (file != nullptr) return file;
+
+				const int error = errno;
+				::close(descriptor);
+				this->RemoveSpillFile();
+
+				throw std::system_error(error, std::generic_category(), "fdopen");
+			}
+#endif
+
+			const int error = errno;
+			this->m_path.clear();
+
+			if (error != EEXIST)
+				throw std::system_error(error, std::generic_category(), "open");
+
+		}
+
+		throw std::system_error(std::make_error_code(std::errc::file_exists), "open");
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::WriteBuffer(std::FILE* const pFile) -> void {
+
+		if (std::fwrite(this->m_buffer.data(), 1, this->m_buffer.size(), pFile) != this->m_buffer.size())
+			throw std::system_error(errno, std::generic_category(), "fwrite");
+
+		this->m_buffer.clear();
+
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::RemoveSpillFile() noexcept -> void {
+
+		if (this->m_path.empty()) return;
+
+		std::error_code ec = { };
+		std::filesystem::remove(this->m_path, ec);
+		this->m_path.clear();
+
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Data() const -> const char* {
+		return (this->m_file.has_value() ? this->m_file->Data() : this->m_buffer.data());
+	}
+
+	template <typename... Columns>
+	inline auto BufferedResult<Columns...>::Size() const -> std::size_t {
+		return (this->m_file.has_value() ? this->m_file->Size() : this->m_buffer.size());
+	}
+
+}
+
+#endif // __VSQLITE3_BUFFEREDRESULT_HPP__
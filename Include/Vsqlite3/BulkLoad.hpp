@@ -0,0 +1,471 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_BULKLOAD_HPP__
+#define __VSQLITE3_BULKLOAD_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/MultiRowInsert.hpp>
+#include <Vsqlite3/SpillCodec.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <tuple>
+#include <array>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <concepts>
+#include <system_error>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	struct BulkLoadOptions {
+		std::size_t rowsPerStatement = 128;
+		bool sortByKey = false;
+		std::size_t sortChunkRows = 1000000;
+		std::size_t sortThreads = 0;
+		bool dropIndexes = true;
+		bool bulkPragmas = true;
+	};
+
+	template <typename... Columns>
+	class BulkLoad {
+
+	public:
+		using Row = std::tuple<Columns...>;
+
+		BulkLoad(Database& db, const std::string_view table, const std::vector<std::string>& columns, const BulkLoadOptions& options = { });
+		BulkLoad(const BulkLoad&) = delete;
+		BulkLoad(BulkLoad&&) = delete;
+		~BulkLoad(void);
+
+		auto operator= (const BulkLoad&) -> BulkLoad& = delete;
+		auto operator= (BulkLoad&&) -> BulkLoad& = delete;
+
+		auto Insert(const Columns&... values) -> void;
+		auto Commit(void) -> void;
+		auto Abort(void) -> void;
+
+		auto DroppedIndexes(void) const -> std::span<const std::pair<std::string, std::string>>;
+		auto Rows(void) const -> std::uint64_t;
+
+	private:
+		using Comparer = bool (*)(const Row&, const Row&);
+		using File = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+		static constexpr bool CanSpill = (Spillable<Columns> && ...);
+
+		Database* m_pDb;
+		std::optional<MultiRowInsert> m_insert;
+		BulkLoadOptions m_options;
+		std::optional<PragmaScope> m_pragmas;
+		std::vector<std::pair<std::string, std::string>> m_indexes;
+		std::vector<std::size_t> m_keyColumns;
+		std::vector<Row> m_pending;
+		std::vector<File> m_runs;
+		std::uint64_t m_rows;
+		std::size_t m_changeMark;
+		bool m_active;
+
+		auto Write(const std::span<const Row> rows) -> void;
+		auto Flush(void) -> void;
+		auto SortPending(void) -> void;
+		auto Spill(void) -> void;
+		auto Merge(void) -> void;
+		auto KeyLess(const Row& lhs, const Row& rhs) const -> bool;
+
+		static auto ReadRow(std::FILE* const pFile, std::string& buffer, Row& row) -> bool;
+
+		template <std::size_t I>
+		static auto Less(const Row& lhs, const Row& rhs) -> bool;
+
+		static constexpr std::string_view Savepoint = "vsqlite3_bulk_load";
+
+	};
+
+	template <typename... Columns>
+	inline BulkLoad<Columns...>::BulkLoad(Database& db, const std::string_view table, const std::vector<std::string>& columns, const BulkLoadOptions& options)
+		: m_pDb(&db), m_options(options), m_rows(0), m_changeMark(0), m_active(false) {
+
+		static_assert((sizeof...(Columns) > 0), "At least one column type must be specified.");
+
+		if (table.empty())
+			throw std::invalid_argument("'table': Empty string.");
+
+		if (columns.size() != sizeof...(Columns))
+			throw std::invalid_argument("'columns': Column count does not match the column types.");
+
+		if (options.rowsPerStatement == 0)
+			throw std::invalid_argument("'options': Rows per statement cannot be zero.");
+
+		const std::string tableName { table };
+
+		if (options.sortByKey) {
+
+			std::vector<std::pair<int, std::string>> keys;
+
+			Statement stmt = { db, "SELECT pk, name FROM pragma_table_info(?) WHERE pk > 0;" };
+			stmt.Bind(tableName);
+
+			int pk = 0;
+			std::string name;
+			while (stmt.Fetch(pk, name))
+				keys.emplace_back(pk, name);
+
+			if (keys.empty())
+				throw std::invalid_argument("'options': Table does not declare a primary key to sort by.");
+
+			std::sort(keys.begin(), keys.end());
+
+			for (const auto& [order, key] : keys) {
+
+				const auto it = std::find_if(columns.begin(), columns.end(), [&key](const std::string& column) { return IsSameIdentifier(column, key); });
+				if (it == columns.end())
+					throw std::invalid_argument("'columns': Primary key column '" + key + "' is not part of the load.");
+
+				this->m_keyColumns.push_back(static_cast<std::size_t>(it - columns.begin()));
+
+			}
+
+		}
+
+		this->m_insert.emplace(db, tableName, columns, options.rowsPerStatement);
+		this->m_options.rowsPerStatement = this->m_insert->RowsPerStatement();
+
+		if (options.bulkPragmas)
+			this->m_pragmas.emplace(PragmaScope::BulkLoad(db));
+
+		try {
+
+			db.Execute("SAVEPOINT " + std::string(BulkLoad::Savepoint) + ";");
+			this->m_changeMark = db.ChangeMark();
+			this->m_active = true;
+
+			if (options.dropIndexes) {
+
+				Statement stmt = { db, "SELECT name, sql FROM sqlite_schema WHERE type = 'index' AND tbl_name = ? COLLATE NOCASE AND sql IS NOT NULL;" };
+				stmt.Bind(tableName);
+
+				std::string name, sql;
+				while (stmt.Fetch(name, sql))
+					this->m_indexes.emplace_back(name, sql);
+
+				stmt.Reset();
+
+				for (const auto& [name, sql] : this->m_indexes)
+					db.Execute("DROP INDEX " + QuoteIdentifier(name) + ";");
+
+			}
+
+		}
+		catch (...) {
+			this->Abort();
+			throw;
+		}
+
+	}
+
+	template <typename... Columns>
+	inline BulkLoad<Columns...>::~BulkLoad() {
+
+		if (!this->m_active) return;
+
+		try { this->Abort(); }
+		catch (...) { }
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Insert(const Columns&... values) -> void {
+
+		if (!this->m_active)
+			throw std::logic_error("Bulk load is not active.");
+
+		this->m_pending.emplace_back(values...);
+
+		if (!this->m_options.sortByKey && (this->m_pending.size() >= this->m_options.rowsPerStatement))
+			this->Flush();
+
+		if constexpr (CanSpill) {
+			if (this->m_options.sortByKey && (this->m_options.sortChunkRows != 0) && (this->m_pending.size() >= this->m_options.sortChunkRows))
+				this->Spill();
+		}
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Commit() -> void {
+
+		if (!this->m_active)
+			throw std::logic_error("Bulk load is not active.");
+
+		try {
+
+			if (this->m_options.sortByKey && !this->m_runs.empty()) {
+				this->Spill();
+				this->Merge();
+			}
+			else if (this->m_options.sortByKey) this->SortPending();
+
+			this->Flush();
+			this->m_insert->Clear();
+
+			for (const auto& [name, sql] : this->m_indexes)
+				this->m_pDb->Execute(sql);
+
+			this->m_pDb->Execute("RELEASE " + std::string(BulkLoad::Savepoint) + ";");
+			this->m_active = false;
+
+		}
+		catch (...) {
+			this->Abort();
+			throw;
+		}
+
+		if (this->m_pragmas.has_value())
+			this->m_pragmas->Restore();
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Abort() -> void {
+
+		this->m_pending.clear();
+		this->m_runs.clear();
+		this->m_insert->Clear();
+
+		if (this->m_active) {
+			this->m_active = false;
+			this->m_pDb->Execute("ROLLBACK TO " + std::string(BulkLoad::Savepoint) + ";");
+			this->m_pDb->DiscardChanges(this->m_changeMark);
+			this->m_pDb->Execute("RELEASE " + std::string(BulkLoad::Savepoint) + ";");
+		}
+
+		if (this->m_pragmas.has_value())
+			this->m_pragmas->Restore();
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::DroppedIndexes() const -> std::span<const std::pair<std::string, std::string>> {
+		return this->m_indexes;
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Rows() const -> std::uint64_t {
+		return this->m_rows;
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Write(const std::span<const Row> rows) -> void {
+
+		std::size_t offset = 0;
+		while (offset < rows.size()) {
+
+			const std::size_t count = std::min(this->m_options.rowsPerStatement, (rows.size() - offset));
+
+			Statement& stmt = this->m_insert->Prepare(count);
+			MultiRowInsert::BindRows(stmt.StatementHandle(), rows.subspan(offset, count));
+
+			stmt.Step();
+			stmt.Reset();
+
+			offset += count;
+			this->m_rows += count;
+
+		}
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Flush() -> void {
+
+		if (this->m_pending.empty()) return;
+
+		this->Write(this->m_pending);
+		this->m_pending.clear();
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::SortPending() -> void {
+
+		const auto less = [this](const Row& lhs, const Row& rhs) { return this->KeyLess(lhs, rhs); };
+		const auto first = this->m_pending.begin();
+		const std::size_t size = this->m_pending.size();
+
+		std::size_t threads = ((this->m_options.sortThreads != 0) ? this->m_options.sortThreads : std::thread::hardware_concurrency());
+		threads = std::clamp<std::size_t>((size / 16384), 1, std::max<std::size_t>(threads, 1));
+
+		if (threads == 1) {
+			std::sort(first, this->m_pending.end(), less);
+			return;
+		}
+
+		std::vector<std::size_t> bounds(threads + 1);
+		for (std::size_t i = 0; i <= threads; ++i)
+			bounds[i] = ((i * size) / threads);
+
+		{
+			std::vector<std::jthread> workers;
+			for (std::size_t i = 0; i < threads; ++i)
+				workers.emplace_back([&, i] { std::sort((first + bounds[i]), (first + bounds[i + 1]), less); });
+		}
+
+		for (std::size_t width = 1; width < threads; width *= 2) {
+
+			std::vector<std::jthread> workers;
+			for (std::size_t i = 0; (i + width) < threads; i += (2 * width)) {
+				const std::size_t lo = bounds[i];
+				const std::size_t mid = bounds[i + width];
+				const std::size_t hi = bounds[std::min((i + (2 * width)), threads)];
+				workers.emplace_back([=] { std::inplace_merge((first + lo), (first + mid), (first + hi), less); });
+			}
+
+		}
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Spill() -> void {
+
+		if constexpr (CanSpill) {
+
+			if (this->m_pending.empty()) return;
+
+			this->SortPending();
+
+			File file = { std::tmpfile(), &std::fclose };
+			if (file == nullptr)
+				throw std::system_error(errno, std::generic_category(), "tmpfile");
+
+			std::string record;
+			for (const Row& row : this->m_pending) {
+
+				record.assign(sizeof(std::uint32_t), '\0');
+				std::apply([&record](const Columns&... values) { (SpillCodec<Columns>::Encode(record, values), ...); }, row);
+
+				const std::uint32_t size = static_cast<std::uint32_t>(record.size() - sizeof(std::uint32_t));
+				std::memcpy(record.data(), &size, sizeof(size));
+
+				if (std::fwrite(record.data(), 1, record.size(), file.get()) != record.size())
+					throw std::system_error(errno, std::generic_category(), "fwrite");
+
+			}
+
+			if ((std::fflush(file.get()) != 0) || (std::fseek(file.get(), 0, SEEK_SET) != 0))
+				throw std::system_error(errno, std::generic_category(), "fflush");
+
+			this->m_runs.push_back(std::move(file));
+			this->m_pending.clear();
+			this->m_pending.shrink_to_fit();
+
+		}
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::Merge() -> void {
+
+		struct Cursor {
+			std::FILE* pFile;
+			std::string buffer;
+			Row row;
+		};
+
+		std::vector<Cursor> cursors;
+		std::vector<std::size_t> heap;
+
+		const auto greater = [this, &cursors](const std::size_t lhs, const std::size_t rhs) {
+			return this->KeyLess(cursors[rhs].row, cursors[lhs].row);
+		};
+
+		cursors.reserve(this->m_runs.size());
+		for (const File& file : this->m_runs) {
+			Cursor& cursor = cursors.emplace_back(Cursor { file.get(), { }, { } });
+			if (BulkLoad::ReadRow(cursor.pFile, cursor.buffer, cursor.row)) heap.push_back(cursors.size() - 1);
+		}
+
+		std::make_heap(heap.begin(), heap.end(), greater);
+
+		while (!heap.empty()) {
+
+			std::pop_heap(heap.begin(), heap.end(), greater);
+			Cursor& cursor = cursors[heap.back()];
+
+			this->m_pending.push_back(std::move(cursor.row));
+			if (BulkLoad::ReadRow(cursor.pFile, cursor.buffer, cursor.row)) std::push_heap(heap.begin(), heap.end(), greater);
+			else heap.pop_back();
+
+			if (this->m_pending.size() >= this->m_options.rowsPerStatement)
+				this->Flush();
+
+		}
+
+		this->m_runs.clear();
+
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::KeyLess(const Row& lhs, const Row& rhs) const -> bool {
+
+		static constexpr std::array<Comparer, sizeof...(Columns)> comparers = []<std::size_t... I>(std::index_sequence<I...>) {
+			return std::array<Comparer, sizeof...(Columns)> { &BulkLoad::Less<I>... };
+		}(std::index_sequence_for<Columns...> { });
+
+		for (const std::size_t column : this->m_keyColumns) {
+			if (comparers[column](lhs, rhs)) return true;
+			if (comparers[column](rhs, lhs)) return false;
+		}
+
+		return false;
+	}
+
+	template <typename... Columns>
+	inline auto BulkLoad<Columns...>::ReadRow(std::FILE* const pFile, std::string& buffer, Row& row) -> bool {
+
+		if constexpr (CanSpill) {
+
+			std::uint32_t size = 0;
+			if (std::fread(&size, 1, sizeof(size), pFile) != sizeof(size)) {
+				if (std::ferror(pFile)) throw std::system_error(errno, std::generic_category(), "fread");
+				return false;
+			}
+
+			buffer.resize(size);
+			if (std::fread(buffer.data(), 1, size, pFile) != size)
+				throw std::system_error(errno, std::generic_category(), "fread");
+
+			const char* in = buffer.data();
+			std::apply([&in](Columns&... values) { (SpillCodec<Columns>::Decode(in, values), ...); }, row);
+
+			return true;
+		}
+		else return false;
+
+	}
+
+	template <typename... Columns>
+	template <std::size_t I>
+	inline auto BulkLoad<Columns...>::Less(const Row& lhs, const Row& rhs) -> bool {
+		return (std::get<I>(lhs) < std::get<I>(rhs));
+	}
+
+}
+
+#endif // __VSQLITE3_BULKLOAD_HPP__
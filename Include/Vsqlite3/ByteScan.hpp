@@ -0,0 +1,131 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_BYTESCAN_HPP__
+#define __VSQLITE3_BYTESCAN_HPP__
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace Vsqlite3 {
+
+	// Word-at-a-time (SWAR) byte searches shared by the CSV importer and the result exporter. Each
+	// scanner tests 8 bytes per iteration and finishes the tail one byte at a time.
+
+	namespace ByteScan {
+
+		inline auto Broadcast(const char ch) -> std::uint64_t {
+			return (0x0101010101010101ull * static_cast<unsigned char>(ch));
+		}
+
+		inline auto ZeroBytes(const std::uint64_t word) -> std::uint64_t {
+			constexpr std::uint64_t low = 0x7F7F7F7F7F7F7F7Full;
+			return ~(((word & low) + low) | word | low);
+		}
+
+		inline auto FirstByte(const std::uint64_t mask) -> std::size_t {
+			if constexpr (std::endian::native == std::endian::little) return static_cast<std::size_t>(std::countr_zero(mask) / 8);
+			else return static_cast<std::size_t>(std::countl_zero(mask) / 8);
+		}
+
+		inline auto FindCsvSpecial(const char* p, const char* const end, const char delimiter) -> const char* {
+
+			const std::uint64_t d = ByteScan::Broadcast(delimiter);
+			const std::uint64_t q = ByteScan::Broadcast('"');
+			const std::uint64_t n = ByteScan::Broadcast('\n');
+			const std::uint64_t r = ByteScan::Broadcast('\r');
+
+			while ((end - p) >= 8) {
+
+				std::uint64_t word = 0;
+				std::memcpy(&word, p, sizeof(word));
+
+				const std::uint64_t mask = (ByteScan::ZeroBytes(word ^ d) | ByteScan::ZeroBytes(word ^ q) | ByteScan::ZeroBytes(word ^ n) | ByteScan::ZeroBytes(word ^ r));
+				if (mask != 0) return (p + ByteScan::FirstByte(mask));
+
+				p += 8;
+
+			}
+
+			while ((p < end) && (*p != delimiter) && (*p != '"') && (*p != '\n') && (*p != '\r'))
+				++p;
+
+			return p;
+		}
+
+		inline auto FindQuoteOrNewline(const char* p, const char* const end) -> const char* {
+
+			const std::uint64_t q = ByteScan::Broadcast('"');
+			const std::uint64_t n = ByteScan::Broadcast('\n');
+
+			while ((end - p) >= 8) {
+
+				std::uint64_t word = 0;
+				std::memcpy(&word, p, sizeof(word));
+
+				const std::uint64_t mask = (ByteScan::ZeroBytes(word ^ q) | ByteScan::ZeroBytes(word ^ n));
+				if (mask != 0) return (p + ByteScan::FirstByte(mask));
+
+				p += 8;
+
+			}
+
+			while ((p < end) && (*p != '"') && (*p != '\n'))
+				++p;
+
+			return p;
+		}
+
+		inline auto CountQuotes(const char* p, const char* const end) -> std::size_t {
+
+			const std::uint64_t q = ByteScan::Broadcast('"');
+			std::size_t count = 0;
+
+			while ((end - p) >= 8) {
+
+				std::uint64_t word = 0;
+				std::memcpy(&word, p, sizeof(word));
+
+				count += static_cast<std::size_t>(std::popcount(ByteScan::ZeroBytes(word ^ q)));
+				p += 8;
+
+			}
+
+			return (count + static_cast<std::size_t>(std::count(p, end, '"')));
+		}
+
+		inline auto FindJsonSpecial(const char* p, const char* const end) -> const char* {
+
+			const std::uint64_t q = ByteScan::Broadcast('"');
+			const std::uint64_t b = ByteScan::Broadcast('\\');
+
+			while ((end - p) >= 8) {
+
+				std::uint64_t word = 0;
+				std::memcpy(&word, p, sizeof(word));
+
+				const std::uint64_t control = ByteScan::ZeroBytes(word & ByteScan::Broadcast(static_cast<char>(0xE0)));
+				const std::uint64_t mask = (control | ByteScan::ZeroBytes(word ^ q) | ByteScan::ZeroBytes(word ^ b));
+				if (mask != 0) return (p + ByteScan::FirstByte(mask));
+
+				p += 8;
+
+			}
+
+			while ((p < end) && (*p != '"') && (*p != '\\') && (static_cast<unsigned char>(*p) >= 0x20))
+				++p;
+
+			return p;
+		}
+
+	}
+
+}
+
+#endif // __VSQLITE3_BYTESCAN_HPP__
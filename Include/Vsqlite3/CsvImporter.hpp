@@ -0,0 +1,577 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_CSVIMPORTER_HPP__
+#define __VSQLITE3_CSVIMPORTER_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/MultiRowInsert.hpp>
+#include <Vsqlite3/ByteScan.hpp>
+#include <Vsqlite3/MappedFile.hpp>
+#include <Vsqlite3/StringArena.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <map>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	struct CsvImportOptions {
+		char delimiter = ',';
+		bool header = true;
+		bool emptyAsNull = false;
+		std::size_t threads = 0;
+		std::size_t chunkSize = (16 * 1024 * 1024);
+		std::size_t rowsPerStatement = 128;
+		std::size_t rowsPerTransaction = 1000000;
+		bool bulkPragmas = true;
+	};
+
+	class CsvImporter {
+
+	public:
+		CsvImporter(Database& db, const std::string_view table, std::vector<std::string> columns = { }, const CsvImportOptions& options = { });
+
+		auto Import(const std::filesystem::path& path) -> std::uint64_t;
+
+	private:
+		enum class Affinity : int {
+			Text,
+			Numeric,
+			Real,
+		};
+
+		struct Field {
+			std::string_view text;
+			std::int64_t integer;
+			double real;
+			int type;
+		};
+
+		struct Batch {
+			std::vector<Field> fields;
+			StringArena strings;
+			std::size_t rows = 0;
+		};
+
+		Database* m_pDb;
+		std::string m_table;
+		std::vector<std::string> m_columns;
+		CsvImportOptions m_options;
+		std::vector<std::pair<std::string, Affinity>> m_tableColumns;
+
+		auto ResolveAffinities(const std::span<const std::string> columns) const -> std::vector<Affinity>;
+		auto ParseRecord(const char*& p, const char* const end, const char* const base, const std::span<const Affinity> affinities, Batch& batch, std::string& scratch) const -> std::size_t;
+		auto ParseChunk(const char* const begin, const char* const end, const char* const base, const std::span<const Affinity> affinities) const -> Batch;
+		auto Classify(Field& field, const bool quoted, const Affinity affinity) const -> void;
+
+		static auto ToAffinity(const std::string_view declaredType) -> Affinity;
+		static auto FindBoundary(const char* p, const char* const end, bool inQuotes) -> const char*;
+
+		[[noreturn]] static auto ThrowMalformed(const char* const base, const char* const position, const std::string_view reason) -> void;
+
+		static constexpr std::string_view Savepoint = "vsqlite3_csv_import";
+		static constexpr std::size_t SampleRows = 64;
+
+	};
+
+	inline CsvImporter::CsvImporter(Database& db, const std::string_view table, std::vector<std::string> columns, const CsvImportOptions& options)
+		: m_pDb(&db), m_table(table), m_columns(std::move(columns)), m_options(options) {
+
+		if (table.empty())
+			throw std::invalid_argument("'table': Empty string.");
+
+		if ((options.delimiter == '"') || (options.delimiter == '\n') || (options.delimiter == '\r'))
+			throw std::invalid_argument("'options': Invalid delimiter.");
+
+		if ((options.chunkSize == 0) || (options.rowsPerStatement == 0))
+			throw std::invalid_argument("'options': Chunk size and rows per statement cannot be zero.");
+
+		Statement stmt = { db, "SELECT name, type FROM pragma_table_info(?);" };
+		stmt.Bind(this->m_table);
+
+		std::string name, type;
+		while (stmt.Fetch(name, type))
+			this->m_tableColumns.emplace_back(name, CsvImporter::ToAffinity(type));
+
+		if (this->m_tableColumns.empty())
+			throw std::invalid_argument("'table': Table does not exist.");
+
+	}
+
+	inline auto CsvImporter::Import(const std::filesystem::path& path) -> std::uint64_t {
+
+		const MappedFile file = { path };
+		const char* const base = file.Data();
+		const char* const end = (base + file.Size());
+
+		const char* dataStart = base;
+		if ((file.Size() >= 3) && (std::memcmp(base, "\xEF\xBB\xBF", 3) == 0))
+			dataStart += 3;
+
+		std::vector<std::string> columns = this->m_columns;
+
+		if (this->m_options.header && (dataStart != end)) {
+
+			Batch header;
+			std::string scratch;
+			const std::vector<Affinity> text(this->m_tableColumns.size(), Affinity::Text);
+
+			while ((dataStart != end) && (this->ParseRecord(dataStart, end, base, text, header, scratch) == 0));
+
+			if (columns.empty())
+				for (const Field& field : header.fields)
+					columns.emplace_back(field.text);
+
+		}
+
+		if (columns.empty())
+			for (const auto& [name, affinity] : this->m_tableColumns)
+				columns.push_back(name);
+
+		const std::vector<Affinity> affinities = this->ResolveAffinities(columns);
+		const std::size_t columnCount = affinities.size();
+
+		sqlite3* const pDb = this->m_pDb->ConnectionHandle();
+
+		MultiRowInsert insert = { *this->m_pDb, this->m_table, columns, this->m_options.rowsPerStatement };
+		const std::size_t rowsPerStatement = insert.RowsPerStatement();
+
+		const std::size_t size = static_cast<std::size_t>(end - dataStart);
+		const std::size_t chunkSize = this->m_options.chunkSize;
+		const std::size_t chunks = ((size + chunkSize - 1) / chunkSize);
+
+		const std::size_t workerCount = std::max<std::size_t>(1, ((this->m_options.threads != 0) ? this->m_options.threads : std::thread::hardware_concurrency()));
+		const std::size_t window = (workerCount * 2);
+
+		struct Pipeline {
+			std::mutex mutex;
+			std::condition_variable signal;
+			std::vector<int> parity;
+			std::vector<int> prefix;
+			std::map<std::size_t, Batch> ready;
+			std::size_t known = 0;
+			std::size_t next = 0;
+			std::size_t written = 0;
+			std::exception_ptr error;
+			bool stop = false;
+		} pipeline;
+
+		pipeline.parity.assign(chunks, -1);
+		pipeline.prefix.assign((chunks + 1), -1);
+		if (!pipeline.prefix.empty()) pipeline.prefix[0] = 0;
+
+		const auto nominal = [&](const std::size_t chunk) -> const char* {
+			return ((chunk >= chunks) ? end : (dataStart + (chunk * chunkSize)));
+		};
+
+		const auto boundary = [&](const std::size_t chunk, const bool inQuotes) -> const char* {
+			if (chunk == 0) return dataStart;
+			if (chunk >= chunks) return end;
+			return CsvImporter::FindBoundary(nominal(chunk), end, inQuotes);
+		};
+
+		const auto work = [&]() -> void {
+
+			while (true) {
+
+				std::size_t chunk = 0;
+				{
+					std::unique_lock<std::mutex> lock(pipeline.mutex);
+					pipeline.signal.wait(lock, [&] { return (pipeline.stop || (pipeline.next >= chunks) || (pipeline.next < (pipeline.written + window))); });
+					if (pipeline.stop || (pipeline.next >= chunks)) return;
+					chunk = pipeline.next++;
+				}
+
+				try {
+
+					const std::size_t quotes = ByteScan::CountQuotes(nominal(chunk), nominal(chunk + 1));
+
+					bool startInQuotes = false, endInQuotes = false;
+					{
+						std::unique_lock<std::mutex> lock(pipeline.mutex);
+
+						pipeline.parity[chunk] = static_cast<int>(quotes & 1);
+						while ((pipeline.known < chunks) && (pipeline.parity[pipeline.known] >= 0)) {
+							pipeline.prefix[pipeline.known + 1] = (pipeline.prefix[pipeline.known] ^ pipeline.parity[pipeline.known]);
+							++pipeline.known;
+						}
+
+						pipeline.signal.notify_all();
+						pipeline.signal.wait(lock, [&] { return (pipeline.stop || (pipeline.prefix[chunk + 1] >= 0)); });
+						if (pipeline.stop) return;
+
+						startInQuotes = (pipeline.prefix[chunk] != 0);
+						endInQuotes = (pipeline.prefix[chunk + 1] != 0);
+					}
+
+					const char* const first = boundary(chunk, startInQuotes);
+					const char* const last = boundary((chunk + 1), endInQuotes);
+
+					Batch batch = ((first < last) ? this->ParseChunk(first, last, base, affinities) : Batch { });
+
+					std::unique_lock<std::mutex> lock(pipeline.mutex);
+					pipeline.ready.emplace(chunk, std::move(batch));
+					pipeline.signal.notify_all();
+
+				}
+				catch (...) {
+					std::unique_lock<std::mutex> lock(pipeline.mutex);
+					if (!pipeline.error) pipeline.error = std::current_exception();
+					pipeline.stop = true;
+					pipeline.signal.notify_all();
+					return;
+				}
+
+			}
+
+		};
+
+		std::optional<PragmaScope> pragmas;
+		if (this->m_options.bulkPragmas)
+			pragmas.emplace(PragmaScope::BulkLoad(*this->m_pDb));
+
+		// Inside the caller's transaction the import runs in a savepoint, so a failure rolls back
+		// only the rows this call inserted.
+
+		const bool ownsTransaction = (sqlite3_get_autocommit(pDb) != 0);
+		const std::size_t changeMark = this->m_pDb->ChangeMark();
+		if (ownsTransaction) this->m_pDb->Execute("BEGIN;");
+		else this->m_pDb->Execute("SAVEPOINT " + std::string(CsvImporter::Savepoint) + ";");
+
+		std::vector<std::thread> workers;
+		std::uint64_t imported = 0;
+		std::size_t uncommitted = 0;
+
+		try {
+
+			for (std::size_t i = 0; i < workerCount; ++i)
+				workers.emplace_back(work);
+
+			for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+
+				Batch batch;
+				{
+					std::unique_lock<std::mutex> lock(pipeline.mutex);
+					pipeline.signal.wait(lock, [&] { return (pipeline.error || pipeline.ready.contains(chunk)); });
+					if (pipeline.error) std::rethrow_exception(pipeline.error);
+
+					auto node = pipeline.ready.extract(chunk);
+					batch = std::move(node.mapped());
+				}
+
+				const Field* pField = batch.fields.data();
+				for (std::size_t row = 0; row < batch.rows; ) {
+
+					const std::size_t rows = std::min(rowsPerStatement, (batch.rows - row));
+					Statement& stmt = insert.Prepare(rows);
+					sqlite3_stmt* const pStmt = stmt.StatementHandle();
+
+					for (int index = 1; index <= static_cast<int>(rows * columnCount); ++index, ++pField) {
+
+						int res = SQLITE_OK;
+						switch (pField->type) {
+						case SQLITE_INTEGER: res = sqlite3_bind_int64(pStmt, index, pField->integer); break;
+						case SQLITE_FLOAT: res = sqlite3_bind_double(pStmt, index, pField->real); break;
+						case SQLITE_TEXT: res = sqlite3_bind_text64(pStmt, index, pField->text.data(), pField->text.size(), SQLITE_STATIC, SQLITE_UTF8); break;
+						default: res = sqlite3_bind_null(pStmt, index); break;
+						}
+
+						if (res != SQLITE_OK)
+							throw SqliteException { pStmt };
+
+					}
+
+					stmt.Step();
+					stmt.Reset();
+
+					row += rows;
+					imported += rows;
+					uncommitted += rows;
+
+					if (ownsTransaction && (this->m_options.rowsPerTransaction != 0) && (uncommitted >= this->m_options.rowsPerTransaction)) {
+						this->m_pDb->Execute("COMMIT;");
+						this->m_pDb->Execute("BEGIN;");
+						uncommitted = 0;
+					}
+
+				}
+
+				std::unique_lock<std::mutex> lock(pipeline.mutex);
+				++pipeline.written;
+				pipeline.signal.notify_all();
+
+			}
+
+			for (std::thread& worker : workers)
+				worker.join();
+
+			insert.Clear();
+			if (ownsTransaction) this->m_pDb->Execute("COMMIT;");
+			else this->m_pDb->Execute("RELEASE " + std::string(CsvImporter::Savepoint) + ";");
+
+		}
+		catch (...) {
+
+			{
+				std::unique_lock<std::mutex> lock(pipeline.mutex);
+				pipeline.stop = true;
+				pipeline.signal.notify_all();
+			}
+
+			for (std::thread& worker : workers)
+				if (worker.joinable()) worker.join();
+
+			insert.Clear();
+
+			if (ownsTransaction && (sqlite3_get_autocommit(pDb) == 0)) {
+				try { this->m_pDb->Execute("ROLLBACK;"); }
+				catch (...) { }
+			}
+			else if (!ownsTransaction) {
+				try {
+					this->m_pDb->Execute("ROLLBACK TO " + std::string(CsvImporter::Savepoint) + ";");
+					this->m_pDb->DiscardChanges(changeMark);
+					this->m_pDb->Execute("RELEASE " + std::string(CsvImporter::Savepoint) + ";");
+				}
+				catch (...) { }
+			}
+
+			throw;
+		}
+
+		return imported;
+	}
+
+	inline auto CsvImporter::ResolveAffinities(const std::span<const std::string> columns) const -> std::vector<Affinity> {
+
+		std::vector<Affinity> affinities;
+		affinities.reserve(columns.size());
+
+		for (const std::string& column : columns) {
+
+			const auto it = std::find_if(this->m_tableColumns.begin(), this->m_tableColumns.end(), [&column](const auto& tableColumn) {
+				return IsSameIdentifier(tableColumn.first, column);
+			});
+
+			if (it == this->m_tableColumns.end())
+				throw std::invalid_argument("'columns': Column '" + column + "' does not exist in table '" + this->m_table + "'.");
+
+			affinities.push_back(it->second);
+
+		}
+
+		return affinities;
+	}
+
+	inline auto CsvImporter::ParseRecord(const char*& p, const char* const end, const char* const base, const std::span<const Affinity> affinities, Batch& batch, std::string& scratch) const -> std::size_t {
+
+		const char delimiter = this->m_options.delimiter;
+
+		if (*p == '\n') {
+			++p;
+			return 0;
+		}
+
+		if ((*p == '\r') && ((p + 1) < end) && (p[1] == '\n')) {
+			p += 2;
+			return 0;
+		}
+
+		std::size_t count = 0;
+		while (true) {
+
+			Field& field = batch.fields.emplace_back();
+			bool quoted = false;
+
+			if ((p < end) && (*p == '"')) {
+
+				quoted = true;
+
+				const char* const text = ++p;
+				const char* src = text;
+				bool escaped = false;
+
+				while (true) {
+
+					const char* const quote = static_cast<const char*>(std::memchr(src, '"', static_cast<std::size_t>(end - src)));
+					if (quote == nullptr)
+						CsvImporter::ThrowMalformed(base, (text - 1), "Unterminated quoted field.");
+
+					if (((quote + 1) < end) && (quote[1] == '"')) {
+						if (!escaped) scratch.clear();
+						scratch.append(src, (quote + 1));
+						src = (quote + 2);
+						escaped = true;
+						continue;
+					}
+
+					if (escaped) {
+						scratch.append(src, quote);
+						field.text = batch.strings.Store(scratch);
+					}
+					else field.text = { text, static_cast<std::size_t>(quote - text) };
+
+					p = (quote + 1);
+					break;
+
+				}
+
+			}
+			else {
+
+				const char* special = ByteScan::FindCsvSpecial(p, end, delimiter);
+				while ((special < end) && (*special == '\r') && !(((special + 1) < end) && (special[1] == '\n')))
+					special = ByteScan::FindCsvSpecial((special + 1), end, delimiter);
+
+				if ((special < end) && (*special == '"'))
+					CsvImporter::ThrowMalformed(base, special, "Quote inside an unquoted field.");
+
+				field.text = { p, static_cast<std::size_t>(special - p) };
+				p = special;
+
+			}
+
+			this->Classify(field, quoted, ((count < affinities.size()) ? affinities[count] : Affinity::Text));
+			++count;
+
+			if (p == end) return count;
+
+			if (*p == delimiter) {
+				++p;
+				continue;
+			}
+
+			if (*p == '\n') {
+				++p;
+				return count;
+			}
+
+			if ((*p == '\r') && ((p + 1) < end) && (p[1] == '\n')) {
+				p += 2;
+				return count;
+			}
+
+			CsvImporter::ThrowMalformed(base, p, "Unexpected character after a quoted field.");
+
+		}
+
+	}
+
+	inline auto CsvImporter::ParseChunk(const char* const begin, const char* const end, const char* const base, const std::span<const Affinity> affinities) const -> Batch {
+
+		Batch batch;
+		batch.fields.reserve(CsvImporter::SampleRows * affinities.size());
+
+		std::string scratch;
+
+		const char* p = begin;
+		while (p < end) {
+
+			const char* const record = p;
+			const std::size_t count = this->ParseRecord(p, end, base, affinities, batch, scratch);
+			if (count == 0) continue;
+
+			if (count != affinities.size())
+				CsvImporter::ThrowMalformed(base, record, ("Record has " + std::to_string(count) + " fields, expected " + std::to_string(affinities.size()) + "."));
+
+			++batch.rows;
+
+			// Once a few records have been parsed, the rest of the chunk is assumed to have the
+			// same average record length.
+
+			if (batch.rows == CsvImporter::SampleRows) {
+				const std::size_t expected = ((static_cast<std::size_t>(end - begin) * batch.rows) / static_cast<std::size_t>(p - begin));
+				batch.fields.reserve((expected + (expected / 8) + 1) * affinities.size());
+			}
+
+		}
+
+		return batch;
+	}
+
+	inline auto CsvImporter::Classify(Field& field, const bool quoted, const Affinity affinity) const -> void {
+
+		const char* const first = field.text.data();
+		const char* const last = (first + field.text.size());
+
+		if (field.text.empty()) {
+			field.type = ((!quoted && this->m_options.emptyAsNull) ? SQLITE_NULL : SQLITE_TEXT);
+			return;
+		}
+
+		if (affinity == Affinity::Numeric) {
+			const auto [ptr, ec] = std::from_chars(first, last, field.integer);
+			if ((ec == std::errc { }) && (ptr == last)) {
+				field.type = SQLITE_INTEGER;
+				return;
+			}
+		}
+
+		if (affinity != Affinity::Text) {
+			const auto [ptr, ec] = std::from_chars(first, last, field.real);
+			if ((ec == std::errc { }) && (ptr == last) && std::isfinite(field.real)) {
+				field.type = SQLITE_FLOAT;
+				return;
+			}
+		}
+
+		field.type = SQLITE_TEXT;
+
+	}
+
+	inline auto CsvImporter::ToAffinity(const std::string_view declaredType) -> Affinity {
+
+		std::string type { declaredType };
+		std::transform(type.begin(), type.end(), type.begin(), [](const unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+
+		if (type.find("INT") != std::string::npos) return Affinity::Numeric;
+		if ((type.find("CHAR") != std::string::npos) || (type.find("CLOB") != std::string::npos) || (type.find("TEXT") != std::string::npos)) return Affinity::Text;
+		if (type.empty() || (type.find("BLOB") != std::string::npos)) return Affinity::Text;
+		if ((type.find("REAL") != std::string::npos) || (type.find("FLOA") != std::string::npos) || (type.find("DOUB") != std::string::npos)) return Affinity::Real;
+
+		return Affinity::Numeric;
+	}
+
+	inline auto CsvImporter::FindBoundary(const char* p, const char* const end, bool inQuotes) -> const char* {
+
+		while (true) {
+
+			p = ByteScan::FindQuoteOrNewline(p, end);
+			if (p == end) return end;
+
+			if (*p == '"') inQuotes = !inQuotes;
+			else if (!inQuotes) return (p + 1);
+
+			++p;
+
+		}
+
+	}
+
+	inline auto CsvImporter::ThrowMalformed(const char* const base, const char* const position, const std::string_view reason) -> void {
+		throw std::runtime_error("Malformed CSV at byte offset " + std::to_string(position - base) + ": " + std::string(reason));
+	}
+
+}
+
+#endif // __VSQLITE3_CSVIMPORTER_HPP__
@@ -0,0 +1,397 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_DATABASEMANAGER_HPP__
+#define __VSQLITE3_DATABASEMANAGER_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <list>
+#include <iterator>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	struct DatabaseManagerOptions {
+		std::size_t maxOpen = 256;
+		std::chrono::seconds idleTimeout = std::chrono::minutes(5);
+		std::size_t cacheBudget = (256 * 1024 * 1024);
+		std::size_t statementCacheSize = 32;
+		DatabaseOpenFlags flags = (DatabaseOpenFlags::ReadWrite | DatabaseOpenFlags::Create);
+	};
+
+	class DatabaseManager {
+
+	private:
+		struct CachedStatement {
+			std::list<std::string>::iterator position;
+			Statement stmt;
+		};
+
+		struct Entry {
+			std::list<std::string>::iterator position;
+			std::mutex mutex;
+			std::optional<Database> db;
+			std::unordered_map<std::string, CachedStatement> statements;
+			std::list<std::string> recentStatements;
+			std::size_t users = 0;
+			std::chrono::steady_clock::time_point lastUsed;
+		};
+
+	public:
+		using Resolver = std::function<std::filesystem::path(const std::string_view tenant)>;
+		using OpenCallback = std::function<void(Database& db, const std::string_view tenant)>;
+
+		class Lease {
+
+		public:
+			Lease(const Lease&) = delete;
+			Lease(Lease&& other) noexcept = default;
+			~Lease(void);
+
+			auto operator= (const Lease&) -> Lease& = delete;
+
+			auto Get(void) const -> Database&;
+			auto operator-> (void) const -> Database*;
+
+			// The returned statement belongs to the tenant's statement cache. Once more than
+			// 'statementCacheSize' distinct statements have been prepared, a later Prepare() can
+			// evict and finalize it, so the reference must not be kept across Prepare() calls.
+
+			auto Prepare(const std::string_view sql) -> Statement&;
+
+		private:
+			DatabaseManager* m_pManager;
+			std::shared_ptr<Entry> m_entry;
+			std::unique_lock<std::mutex> m_lock;
+
+			Lease(DatabaseManager* const pManager, std::shared_ptr<Entry> entry);
+
+			friend class DatabaseManager;
+
+		};
+
+		DatabaseManager(Resolver resolve, const DatabaseManagerOptions& options = { }, OpenCallback onOpen = nullptr);
+		DatabaseManager(const DatabaseManager&) = delete;
+		DatabaseManager(DatabaseManager&&) = delete;
+
+		auto operator= (const DatabaseManager&) -> DatabaseManager& = delete;
+		auto operator= (DatabaseManager&&) -> DatabaseManager& = delete;
+
+		auto Acquire(const std::string_view tenant) -> Lease;
+		auto CloseIdle(void) -> std::size_t;
+		auto OpenCount(void) const -> std::size_t;
+
+	private:
+		Resolver m_resolve;
+		OpenCallback m_onOpen;
+		DatabaseManagerOptions m_options;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_capacity;
+		std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
+		std::list<std::string> m_recent;
+		std::size_t m_open;
+
+		auto Open(Entry& entry, const std::string_view tenant) -> void;
+		auto Release(const std::shared_ptr<Entry>& entry) -> void;
+		auto EvictOne(void) -> std::shared_ptr<Entry>;
+		auto Remove(const std::string& tenant) -> std::shared_ptr<Entry>;
+		auto HoldsLease(const Entry& entry) const -> bool;
+		auto HoldsOtherLease(const Entry& entry) const -> bool;
+
+		static auto HeldLeases(void) -> std::vector<std::pair<const DatabaseManager*, const Entry*>>&;
+
+	};
+
+	inline DatabaseManager::Lease::Lease(DatabaseManager* const pManager, std::shared_ptr<Entry> entry)
+		: m_pManager(pManager), m_entry(std::move(entry)), m_lock(this->m_entry->mutex) {
+		DatabaseManager::HeldLeases().emplace_back(pManager, this->m_entry.get());
+	}
+
+	inline DatabaseManager::Lease::~Lease() {
+
+		if (this->m_entry == nullptr) return;
+
+		auto& held = DatabaseManager::HeldLeases();
+		const auto it = std::find(held.rbegin(), held.rend(), std::pair<const DatabaseManager*, const Entry*> { this->m_pManager, this->m_entry.get() });
+		if (it != held.rend()) held.erase(std::next(it).base());
+
+		// The tenant lock is dropped before the entry is unpinned; once unpinned, the entry may be
+		// evicted and destroyed by another thread at any time.
+
+		this->m_lock.unlock();
+		this->m_pManager->Release(this->m_entry);
+
+	}
+
+	inline auto DatabaseManager::Lease::Get() const -> Database& {
+		return this->m_entry->db.value();
+	}
+
+	inline auto DatabaseManager::Lease::operator-> () const -> Database* {
+		return &this->m_entry->db.value();
+	}
+
+	inline auto DatabaseManager::Lease::Prepare(const std::string_view sql) -> Statement& {
+
+		Entry& entry = *this->m_entry;
+
+		// Cached statements are handed out reset and unbound, whatever the previous lease left
+		// them in. The first sqlite3_reset() consumes an error left by the last step, so it is not
+		// reported to a lease that had nothing to do with it.
+
+		std::string key = { sql.begin(), sql.end() };
+		auto it = entry.statements.find(key);
+		if (it != entry.statements.end()) {
+
+			entry.recentStatements.splice(entry.recentStatements.begin(), entry.recentStatements, it->second.position);
+
+			Statement& stmt = it->second.stmt;
+			sqlite3_reset(stmt.StatementHandle());
+			stmt.Reset();
+			stmt.Unbind();
+
+			return stmt;
+		}
+
+		Statement stmt = { entry.db.value(), sql };
+
+		while (!entry.recentStatements.empty() && (entry.statements.size() >= this->m_pManager->m_options.statementCacheSize)) {
+			entry.statements.erase(entry.recentStatements.back());
+			entry.recentStatements.pop_back();
+		}
+
+		entry.recentStatements.push_front(key);
+		return entry.statements.emplace(std::move(key), CachedStatement { entry.recentStatements.begin(), std::move(stmt) }).first->second.stmt;
+	}
+
+	inline DatabaseManager::DatabaseManager(Resolver resolve, const DatabaseManagerOptions& options, OpenCallback onOpen)
+		: m_resolve(std::move(resolve)), m_onOpen(std::move(onOpen)), m_options(options), m_open(0) {
+
+		if (!this->m_resolve)
+			throw std::invalid_argument("'resolve': Empty function.");
+
+		if (options.maxOpen == 0)
+			throw std::invalid_argument("'options': Maximum open connection count cannot be zero.");
+
+	}
+
+	inline auto DatabaseManager::Acquire(const std::string_view tenant) -> Lease {
+
+		if (tenant.empty())
+			throw std::invalid_argument("'tenant': Empty string.");
+
+		std::shared_ptr<Entry> entry;
+		std::vector<std::shared_ptr<Entry>> closed;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			// Least recently used entries sit at the back. Idle ones are closed on the way in,
+			// which keeps the sweep proportional to what has actually expired.
+
+			const auto now = std::chrono::steady_clock::now();
+			for (auto it = this->m_recent.end(); (it != this->m_recent.begin()) && (this->m_options.idleTimeout.count() > 0); ) {
+
+				const auto current = std::prev(it);
+				const std::shared_ptr<Entry>& candidate = this->m_entries.at(*current);
+
+				if (candidate->users != 0) it = current;
+				else if ((now - candidate->lastUsed) < this->m_options.idleTimeout) break;
+				else closed.push_back(this->Remove(*current));
+
+			}
+
+			std::string key = { tenant.begin(), tenant.end() };
+			auto it = this->m_entries.find(key);
+
+			// Leases are bound to the thread that acquired them. Taking the same tenant again would
+			// lock its mutex twice.
+
+			if ((it != this->m_entries.end()) && this->HoldsLease(*it->second))
+				throw std::logic_error("Tenant is already leased by this thread.");
+
+			if (it == this->m_entries.end()) {
+				entry = std::make_shared<Entry>();
+				this->m_recent.push_front(key);
+				entry->position = this->m_recent.begin();
+				this->m_entries.emplace(std::move(key), entry);
+			}
+			else {
+				entry = it->second;
+				this->m_recent.splice(this->m_recent.begin(), this->m_recent, entry->position);
+			}
+
+			++entry->users;
+		}
+
+		closed.clear();
+
+		Lease lease = { this, entry };
+		if (!entry->db.has_value()) this->Open(*entry, tenant);
+
+		return lease;
+	}
+
+	inline auto DatabaseManager::CloseIdle() -> std::size_t {
+
+		std::vector<std::shared_ptr<Entry>> closed;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			const auto now = std::chrono::steady_clock::now();
+			for (auto it = this->m_recent.begin(); it != this->m_recent.end(); ) {
+
+				const std::shared_ptr<Entry>& candidate = this->m_entries.at(*it);
+				if ((candidate->users != 0) || ((now - candidate->lastUsed) < this->m_options.idleTimeout)) ++it;
+				else closed.push_back(this->Remove(*it++));
+
+			}
+		}
+
+		return closed.size();
+	}
+
+	inline auto DatabaseManager::OpenCount() const -> std::size_t {
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		return this->m_open;
+	}
+
+	inline auto DatabaseManager::Open(Entry& entry, const std::string_view tenant) -> void {
+
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+
+			// At the cap, the least recently used unpinned connection is closed to make room. If every
+			// open connection is leased, wait for one to be returned, unless this thread holds one of
+			// them: waiting while holding a lease can deadlock, and always does when this thread's
+			// lease is the one needed. The victim is destroyed outside the lock so sqlite3_close()
+			// does not stall other tenants.
+
+			while (this->m_open >= this->m_options.maxOpen) {
+
+				std::shared_ptr<Entry> victim = this->EvictOne();
+
+				if (victim == nullptr) {
+					if (this->HoldsOtherLease(entry))
+						throw std::logic_error("All connections are leased and this thread holds one of them.");
+					this->m_capacity.wait(lock);
+				}
+				else {
+					lock.unlock();
+					victim.reset();
+					lock.lock();
+				}
+
+			}
+
+			++this->m_open;
+		}
+
+		try {
+
+			const std::string path = this->m_resolve(tenant).string();
+			entry.db.emplace(path, this->m_options.flags);
+
+			// The page cache budget is split evenly, so all open connections together stay within it.
+
+			const std::size_t kibibytes = std::max<std::size_t>(64, ((this->m_options.cacheBudget / this->m_options.maxOpen) / 1024));
+			entry.db->Execute("PRAGMA cache_size = -" + std::to_string(kibibytes) + ";");
+
+			if (this->m_onOpen) this->m_onOpen(entry.db.value(), tenant);
+
+		}
+		catch (...) {
+
+			entry.statements.clear();
+			entry.recentStatements.clear();
+			entry.db.reset();
+
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				--this->m_open;
+			}
+
+			this->m_capacity.notify_one();
+			throw;
+		}
+
+	}
+
+	inline auto DatabaseManager::Release(const std::shared_ptr<Entry>& entry) -> void {
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			entry->lastUsed = std::chrono::steady_clock::now();
+			--entry->users;
+
+			if ((entry->users == 0) && !entry->db.has_value())
+				this->Remove(*entry->position);
+		}
+
+		this->m_capacity.notify_one();
+
+	}
+
+	inline auto DatabaseManager::EvictOne() -> std::shared_ptr<Entry> {
+
+		for (auto it = this->m_recent.rbegin(); it != this->m_recent.rend(); ++it)
+			if (this->m_entries.at(*it)->users == 0) return this->Remove(*it);
+
+		return nullptr;
+	}
+
+	inline auto DatabaseManager::Remove(const std::string& tenant) -> std::shared_ptr<Entry> {
+
+		auto it = this->m_entries.find(tenant);
+		std::shared_ptr<Entry> entry = std::move(it->second);
+
+		if (entry->db.has_value()) --this->m_open;
+
+		this->m_entries.erase(it);
+		this->m_recent.erase(entry->position);
+
+		return entry;
+	}
+
+	inline auto DatabaseManager::HoldsLease(const Entry& entry) const -> bool {
+		return std::any_of(DatabaseManager::HeldLeases().begin(), DatabaseManager::HeldLeases().end(), [this, &entry](const auto& held) {
+			return ((held.first == this) && (held.second == &entry));
+		});
+	}
+
+	inline auto DatabaseManager::HoldsOtherLease(const Entry& entry) const -> bool {
+		return std::any_of(DatabaseManager::HeldLeases().begin(), DatabaseManager::HeldLeases().end(), [this, &entry](const auto& held) {
+			return ((held.first == this) && (held.second != &entry));
+		});
+	}
+
+	inline auto DatabaseManager::HeldLeases() -> std::vector<std::pair<const DatabaseManager*, const Entry*>>& {
+		thread_local std::vector<std::pair<const DatabaseManager*, const Entry*>> held;
+		return held;
+	}
+
+}
+
+#endif // __VSQLITE3_DATABASEMANAGER_HPP__
@@ -0,0 +1,140 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_INSERTRETURNING_HPP__
+#define __VSQLITE3_INSERTRETURNING_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/MultiRowInsert.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	// SQLite does not specify the order in which RETURNING emits rows, so results are not guaranteed
+	// to line up with the order of Add() calls. To pair a result with its input row, include a
+	// column from the input (a natural key) in 'returning' and match on it.
+
+	template <typename Returned, typename... Columns>
+	class InsertReturning {
+
+	public:
+		using Row = std::tuple<Columns...>;
+
+		InsertReturning(Database& db, const std::string_view table, const std::vector<std::string>& columns, const std::string_view returning = "rowid", const std::size_t rowsPerStatement = 128);
+
+		auto Add(const Columns&... values) -> void;
+		auto Flush(void) -> void;
+		auto Finish(void) -> std::vector<Returned>;
+
+		auto Results(void) const -> std::span<const Returned>;
+
+	private:
+		MultiRowInsert m_insert;
+		std::vector<Row> m_pending;
+		std::vector<Returned> m_results;
+
+		auto Read(sqlite3_stmt* const pStmt, Returned& result) -> void;
+
+		template <typename T>
+		struct IsTuple : std::false_type { };
+
+		template <typename... T>
+		struct IsTuple<std::tuple<T...>> : std::true_type { };
+
+	};
+
+	template <typename Returned, typename... Columns>
+	inline InsertReturning<Returned, Columns...>::InsertReturning(Database& db, const std::string_view table, const std::vector<std::string>& columns, const std::string_view returning, const std::size_t rowsPerStatement)
+		: m_insert(db, table, columns, rowsPerStatement, returning) {
+
+		static_assert((sizeof...(Columns) > 0), "At least one column type must be specified.");
+
+		if (returning.empty())
+			throw std::invalid_argument("'returning': Empty string.");
+
+		if (columns.size() != sizeof...(Columns))
+			throw std::invalid_argument("'columns': Column count does not match the column types.");
+
+	}
+
+	template <typename Returned, typename... Columns>
+	inline auto InsertReturning<Returned, Columns...>::Add(const Columns&... values) -> void {
+
+		this->m_pending.emplace_back(values...);
+
+		if (this->m_pending.size() >= this->m_insert.RowsPerStatement())
+			this->Flush();
+
+	}
+
+	template <typename Returned, typename... Columns>
+	inline auto InsertReturning<Returned, Columns...>::Flush() -> void {
+
+		if (this->m_pending.empty()) return;
+
+		Statement& stmt = this->m_insert.Prepare(this->m_pending.size());
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+
+		MultiRowInsert::BindRows(pStmt, std::span<const Row> { this->m_pending });
+
+		const std::size_t count = this->m_results.size();
+
+		try {
+
+			stmt.Step();
+			while (sqlite3_data_count(pStmt) > 0) {
+				this->Read(pStmt, this->m_results.emplace_back());
+				stmt.Step();
+			}
+
+		}
+		catch (...) {
+			sqlite3_reset(pStmt);
+			this->m_results.resize(count);
+			this->m_pending.clear();
+			throw;
+		}
+
+		stmt.Reset();
+		this->m_pending.clear();
+
+	}
+
+	template <typename Returned, typename... Columns>
+	inline auto InsertReturning<Returned, Columns...>::Finish() -> std::vector<Returned> {
+		this->Flush();
+		return std::exchange(this->m_results, { });
+	}
+
+	template <typename Returned, typename... Columns>
+	inline auto InsertReturning<Returned, Columns...>::Results() const -> std::span<const Returned> {
+		return this->m_results;
+	}
+
+	template <typename Returned, typename... Columns>
+	inline auto InsertReturning<Returned, Columns...>::Read(sqlite3_stmt* const pStmt, Returned& result) -> void {
+
+		if constexpr (IsTuple<Returned>::value) {
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				(Binding<std::tuple_element_t<I, Returned>>::Column(pStmt, static_cast<int>(I), std::get<I>(result)), ...);
+			}(std::make_index_sequence<std::tuple_size_v<Returned>> { });
+		}
+		else Binding<Returned>::Column(pStmt, 0, result);
+
+	}
+
+}
+
+#endif // __VSQLITE3_INSERTRETURNING_HPP__
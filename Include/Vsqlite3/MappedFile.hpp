@@ -0,0 +1,166 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_MAPPEDFILE_HPP__
+#define __VSQLITE3_MAPPEDFILE_HPP__
+
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <cstddef>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#endif
+
+namespace Vsqlite3 {
+
+	class MappedFile {
+
+	public:
+		MappedFile(const std::filesystem::path& path, const bool copyOnWrite = false);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		~MappedFile(void);
+
+		auto operator= (const MappedFile&) -> MappedFile& = delete;
+		auto operator= (MappedFile&& other) noexcept -> MappedFile&;
+
+		auto Data(void) const -> char*;
+		auto Size(void) const -> std::size_t;
+
+	private:
+		char* m_pData;
+		std::size_t m_size;
+
+		auto Unmap(void) -> void;
+
+	};
+
+	inline MappedFile::MappedFile(const std::filesystem::path& path, const bool copyOnWrite) : m_pData(nullptr), m_size(0) {
+
+#if defined(_WIN32)
+
+		const HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE)
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "CreateFileW");
+
+		LARGE_INTEGER size = { };
+		if (!GetFileSizeEx(hFile, &size)) {
+			const DWORD error = GetLastError();
+			CloseHandle(hFile);
+			throw std::system_error(static_cast<int>(error), std::system_category(), "GetFileSizeEx");
+		}
+
+		if (size.QuadPart == 0) {
+			CloseHandle(hFile);
+			return;
+		}
+
+		const HANDLE hMapping = CreateFileMappingW(hFile, nullptr, (copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY), 0, 0, nullptr);
+		const DWORD mappingError = GetLastError();
+		CloseHandle(hFile);
+
+		if (hMapping == nullptr)
+			throw std::system_error(static_cast<int>(mappingError), std::system_category(), "CreateFileMappingW");
+
+		void* const pView = MapViewOfFile(hMapping, (copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ), 0, 0, 0);
+		const DWORD viewError = GetLastError();
+		CloseHandle(hMapping);
+
+		if (pView == nullptr)
+			throw std::system_error(static_cast<int>(viewError), std::system_category(), "MapViewOfFile");
+
+		this->m_pData = static_cast<char*>(pView);
+		this->m_size = static_cast<std::size_t>(size.QuadPart);
+
+#else
+
+		const int fd = open(path.c_str(), (O_RDONLY | O_CLOEXEC));
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), "open");
+
+		struct stat st = { };
+		if (fstat(fd, &st) != 0) {
+			const int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(), "fstat");
+		}
+
+		if (st.st_size == 0) {
+			close(fd);
+			return;
+		}
+
+		void* const pView = mmap(nullptr, static_cast<std::size_t>(st.st_size), (copyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ), MAP_PRIVATE, fd, 0);
+		const int error = errno;
+		close(fd);
+
+		if (pView == MAP_FAILED)
+			throw std::system_error(error, std::generic_category(), "mmap");
+
+		madvise(pView, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+		this->m_pData = static_cast<char*>(pView);
+		this->m_size = static_cast<std::size_t>(st.st_size);
+
+#endif
+
+	}
+
+	inline MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_pData(std::exchange(other.m_pData, nullptr)), m_size(std::exchange(other.m_size, 0)) { }
+
+	inline MappedFile::~MappedFile() {
+		this->Unmap();
+	}
+
+	inline auto MappedFile::operator= (MappedFile&& other) noexcept -> MappedFile& {
+
+		if (this != &other) {
+			this->Unmap();
+			this->m_pData = std::exchange(other.m_pData, nullptr);
+			this->m_size = std::exchange(other.m_size, 0);
+		}
+
+		return static_cast<MappedFile&>(*this);
+	}
+
+	inline auto MappedFile::Data() const -> char* {
+		return this->m_pData;
+	}
+
+	inline auto MappedFile::Size() const -> std::size_t {
+		return this->m_size;
+	}
+
+	inline auto MappedFile::Unmap() -> void {
+
+		if (this->m_pData == nullptr) return;
+
+#if defined(_WIN32)
+		UnmapViewOfFile(this->m_pData);
+#else
+		munmap(this->m_pData, this->m_size);
+#endif
+
+		this->m_pData = nullptr;
+		this->m_size = 0;
+
+	}
+
+}
+
+#endif // __VSQLITE3_MAPPEDFILE_HPP__
@@ -0,0 +1,596 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_MEMORYVFS_HPP__
+#define __VSQLITE3_MEMORYVFS_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	struct MemoryVfsOptions {
+		std::size_t chunkSize = (64 * 1024);
+		std::size_t maxFileSize = 0;
+		std::size_t maxCachedChunks = 256;
+	};
+
+	class MemoryVfs {
+
+	public:
+		MemoryVfs(const std::string_view name, const MemoryVfsOptions& options = { }, const bool makeDefault = false);
+		MemoryVfs(const MemoryVfs&) = delete;
+		MemoryVfs(MemoryVfs&&) = delete;
+		~MemoryVfs(void);
+
+		auto operator= (const MemoryVfs&) -> MemoryVfs& = delete;
+		auto operator= (MemoryVfs&&) -> MemoryVfs& = delete;
+
+		auto Name(void) const -> std::string_view;
+		auto Options(void) const -> const MemoryVfsOptions&;
+
+	private:
+		using Chunk = std::unique_ptr<std::byte[]>;
+
+		struct Storage {
+
+			Storage(MemoryVfs* const pOwner);
+			Storage(const Storage&) = delete;
+			~Storage(void);
+
+			auto operator= (const Storage&) -> Storage& = delete;
+
+			MemoryVfs* pOwner;
+			std::mutex mutex;
+			std::vector<Chunk> chunks;
+			sqlite3_int64 size;
+			int sharedLocks;
+			const void* pWriter;
+			bool pending;
+			bool exclusive;
+
+		};
+
+		struct File {
+			sqlite3_file base;
+			MemoryVfs* pVfs;
+			std::shared_ptr<Storage> storage;
+			std::string name;
+			int lock;
+		};
+
+		static auto Self(sqlite3_vfs* const pVfs) -> MemoryVfs*;
+
+		auto AcquireChunk(void) -> Chunk;
+		auto RecycleChunks(std::vector<Chunk>& chunks, const std::size_t first) -> void;
+		auto Copy(Storage& storage, void* pBuf, const std::size_t amount, const sqlite3_int64 offset) const -> void;
+		auto Fill(Storage& storage, const void* pBuf, const std::size_t amount, const sqlite3_int64 offset) const -> void;
+
+		static auto Open(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, int* pOutFlags) -> int;
+		static auto Delete(sqlite3_vfs* pVfs, const char* zName, int syncDir) -> int;
+		static auto Access(sqlite3_vfs* pVfs, const char* zName, int flags, int* pResOut) -> int;
+		static auto FullPathname(sqlite3_vfs* pVfs, const char* zName, int nOut, char* zOut) -> int;
+		static auto DlOpen(sqlite3_vfs* pVfs, const char* zFilename) -> void*;
+		static auto DlError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> void;
+		static auto DlSym(sqlite3_vfs* pVfs, void* pHandle, const char* zSymbol) -> void (*)(void);
+		static auto DlClose(sqlite3_vfs* pVfs, void* pHandle) -> void;
+		static auto Randomness(sqlite3_vfs* pVfs, int nByte, char* zOut) -> int;
+		static auto Sleep(sqlite3_vfs* pVfs, int microseconds) -> int;
+		static auto CurrentTime(sqlite3_vfs* pVfs, double* pTime) -> int;
+		static auto GetLastError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> int;
+		static auto CurrentTimeInt64(sqlite3_vfs* pVfs, sqlite3_int64* pTime) -> int;
+
+		static auto Close(sqlite3_file* pFile) -> int;
+		static auto Read(sqlite3_file* pFile, void* pBuf, int amount, sqlite3_int64 offset) -> int;
+		static auto Write(sqlite3_file* pFile, const void* pBuf, int amount, sqlite3_int64 offset) -> int;
+		static auto Truncate(sqlite3_file* pFile, sqlite3_int64 size) -> int;
+		static auto Sync(sqlite3_file* pFile, int flags) -> int;
+		static auto FileSize(sqlite3_file* pFile, sqlite3_int64* pSize) -> int;
+		static auto Lock(sqlite3_file* pFile, int lock) -> int;
+		static auto Unlock(sqlite3_file* pFile, int lock) -> int;
+		static auto CheckReservedLock(sqlite3_file* pFile, int* pResOut) -> int;
+		static auto FileControl(sqlite3_file* pFile, int op, void* pArg) -> int;
+		static auto SectorSize(sqlite3_file* pFile) -> int;
+		static auto DeviceCharacteristics(sqlite3_file* pFile) -> int;
+
+		std::string m_name;
+		MemoryVfsOptions m_options;
+		sqlite3_vfs* m_pBase;
+		sqlite3_vfs m_vfs;
+		sqlite3_io_methods m_methods;
+
+		std::mutex m_filesMutex;
+		std::unordered_map<std::string, std::weak_ptr<Storage>> m_files;
+
+		std::mutex m_chunksMutex;
+		std::vector<Chunk> m_cachedChunks;
+
+	};
+
+	inline MemoryVfs::Storage::Storage(MemoryVfs* const pOwner)
+		: pOwner(pOwner), size(0), sharedLocks(0), pWriter(nullptr), pending(false), exclusive(false) { }
+
+	inline MemoryVfs::Storage::~Storage() {
+		this->pOwner->RecycleChunks(this->chunks, 0);
+	}
+
+	inline MemoryVfs::MemoryVfs(const std::string_view name, const MemoryVfsOptions& options, const bool makeDefault) {
+
+		if (name.empty())
+			throw std::invalid_argument("'name': Empty string.");
+
+		if (options.chunkSize == 0)
+			throw std::invalid_argument("'options': Chunk size cannot be zero.");
+
+		this->m_name = name;
+		this->m_options = options;
+
+		this->m_pBase = sqlite3_vfs_find(nullptr);
+		if (this->m_pBase == nullptr)
+			throw std::runtime_error("Default VFS does not exist.");
+
+		std::memset(&this->m_methods, 0, sizeof(this->m_methods));
+		this->m_methods.iVersion = 1;
+		this->m_methods.xClose = &MemoryVfs::Close;
+		this->m_methods.xRead = &MemoryVfs::Read;
+		this->m_methods.xWrite = &MemoryVfs::Write;
+		this->m_methods.xTruncate = &MemoryVfs::Truncate;
+		this->m_methods.xSync = &MemoryVfs::Sync;
+		this->m_methods.xFileSize = &MemoryVfs::FileSize;
+		this->m_methods.xLock = &MemoryVfs::Lock;
+		this->m_methods.xUnlock = &MemoryVfs::Unlock;
+		this->m_methods.xCheckReservedLock = &MemoryVfs::CheckReservedLock;
+		this->m_methods.xFileControl = &MemoryVfs::FileControl;
+		this->m_methods.xSectorSize = &MemoryVfs::SectorSize;
+		this->m_methods.xDeviceCharacteristics = &MemoryVfs::DeviceCharacteristics;
+
+		std::memset(&this->m_vfs, 0, sizeof(this->m_vfs));
+		this->m_vfs.iVersion = 2;
+		this->m_vfs.szOsFile = static_cast<int>(sizeof(File));
+		this->m_vfs.mxPathname = 1024;
+		this->m_vfs.zName = this->m_name.c_str();
+		this->m_vfs.pAppData = this;
+		this->m_vfs.xOpen = &MemoryVfs::Open;
+		this->m_vfs.xDelete = &MemoryVfs::Delete;
+		this->m_vfs.xAccess = &MemoryVfs::Access;
+		this->m_vfs.xFullPathname = &MemoryVfs::FullPathname;
+		this->m_vfs.xDlOpen = &MemoryVfs::DlOpen;
+		this->m_vfs.xDlError = &MemoryVfs::DlError;
+		this->m_vfs.xDlSym = &MemoryVfs::DlSym;
+		this->m_vfs.xDlClose = &MemoryVfs::DlClose;
+		this->m_vfs.xRandomness = &MemoryVfs::Randomness;
+		this->m_vfs.xSleep = &MemoryVfs::Sleep;
+		this->m_vfs.xCurrentTime = &MemoryVfs::CurrentTime;
+		this->m_vfs.xGetLastError = &MemoryVfs::GetLastError;
+		this->m_vfs.xCurrentTimeInt64 = &MemoryVfs::CurrentTimeInt64;
+
+		const int res = sqlite3_vfs_register(&this->m_vfs, (makeDefault ? 1 : 0));
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline MemoryVfs::~MemoryVfs() {
+		sqlite3_vfs_unregister(&this->m_vfs);
+	}
+
+	inline auto MemoryVfs::Name() const -> std::string_view {
+		return this->m_name;
+	}
+
+	inline auto MemoryVfs::Options() const -> const MemoryVfsOptions& {
+		return this->m_options;
+	}
+
+	inline auto MemoryVfs::Self(sqlite3_vfs* const pVfs) -> MemoryVfs* {
+		return static_cast<MemoryVfs*>(pVfs->pAppData);
+	}
+
+	inline auto MemoryVfs::AcquireChunk() -> Chunk {
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_chunksMutex);
+			if (!this->m_cachedChunks.empty()) {
+				Chunk chunk = std::move(this->m_cachedChunks.back());
+				this->m_cachedChunks.pop_back();
+				return chunk;
+			}
+		}
+
+		return Chunk { new (std::nothrow) std::byte[this->m_options.chunkSize] };
+	}
+
+	inline auto MemoryVfs::RecycleChunks(std::vector<Chunk>& chunks, const std::size_t first) -> void {
+
+		if (first >= chunks.size()) return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_chunksMutex);
+			for (std::size_t i = first; i < chunks.size(); ++i) {
+				if (this->m_cachedChunks.size() >= this->m_options.maxCachedChunks) break;
+				this->m_cachedChunks.push_back(std::move(chunks[i]));
+			}
+		}
+
+		chunks.resize(first);
+
+	}
+
+	inline auto MemoryVfs::Copy(Storage& storage, void* pBuf, const std::size_t amount, const sqlite3_int64 offset) const -> void {
+
+		const std::size_t chunkSize = this->m_options.chunkSize;
+		std::byte* pOut = static_cast<std::byte*>(pBuf);
+		std::size_t position = static_cast<std::size_t>(offset);
+		std::size_t remaining = amount;
+
+		while (remaining > 0) {
+			const std::size_t inChunk = (position % chunkSize);
+			const std::size_t len = std::min(remaining, (chunkSize - inChunk));
+			std::memcpy(pOut, (storage.chunks[position / chunkSize].get() + inChunk), len);
+			pOut += len;
+			position += len;
+			remaining -= len;
+		}
+
+	}
+
+	inline auto MemoryVfs::Fill(Storage& storage, const void* pBuf, const std::size_t amount, const sqlite3_int64 offset) const -> void {
+
+		const std::size_t chunkSize = this->m_options.chunkSize;
+		const std::byte* pIn = static_cast<const std::byte*>(pBuf);
+		std::size_t position = static_cast<std::size_t>(offset);
+		std::size_t remaining = amount;
+
+		while (remaining > 0) {
+			const std::size_t inChunk = (position % chunkSize);
+			const std::size_t len = std::min(remaining, (chunkSize - inChunk));
+			std::byte* pChunk = (storage.chunks[position / chunkSize].get() + inChunk);
+			if (pIn != nullptr) std::memcpy(pChunk, pIn, len);
+			else std::memset(pChunk, 0, len);
+			if (pIn != nullptr) pIn += len;
+			position += len;
+			remaining -= len;
+		}
+
+	}
+
+	inline auto MemoryVfs::Open(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, int* pOutFlags) -> int {
+
+		MemoryVfs* const pSelf = MemoryVfs::Self(pVfs);
+		pFile->pMethods = nullptr;
+
+		std::shared_ptr<Storage> storage;
+		std::string name = ((zName != nullptr) ? zName : "");
+
+		try {
+
+			if (name.empty()) storage = std::make_shared<Storage>(pSelf);
+			else {
+
+				std::lock_guard<std::mutex> lock(pSelf->m_filesMutex);
+
+				std::weak_ptr<Storage>& entry = pSelf->m_files[name];
+				storage = entry.lock();
+
+				if (!storage) {
+
+					if ((flags & SQLITE_OPEN_CREATE) == 0) {
+						pSelf->m_files.erase(name);
+						return SQLITE_CANTOPEN;
+					}
+
+					storage = std::make_shared<Storage>(pSelf);
+					entry = storage;
+
+				}
+
+			}
+
+		}
+		catch (const std::bad_alloc&) {
+			return SQLITE_NOMEM;
+		}
+
+		new (pFile) File { { &pSelf->m_methods }, pSelf, std::move(storage), std::move(name), SQLITE_LOCK_NONE };
+
+		if (pOutFlags != nullptr) *pOutFlags = flags;
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Delete(sqlite3_vfs* pVfs, const char* zName, int) -> int {
+
+		MemoryVfs* const pSelf = MemoryVfs::Self(pVfs);
+
+		std::lock_guard<std::mutex> lock(pSelf->m_filesMutex);
+		pSelf->m_files.erase(zName);
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Access(sqlite3_vfs* pVfs, const char* zName, int, int* pResOut) -> int {
+
+		MemoryVfs* const pSelf = MemoryVfs::Self(pVfs);
+
+		std::lock_guard<std::mutex> lock(pSelf->m_filesMutex);
+		const auto it = pSelf->m_files.find(zName);
+		*pResOut = (((it != pSelf->m_files.end()) && !it->second.expired()) ? 1 : 0);
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::FullPathname(sqlite3_vfs*, const char* zName, int nOut, char* zOut) -> int {
+
+		const std::size_t len = std::strlen(zName);
+		if (len >= static_cast<std::size_t>(nOut)) return SQLITE_CANTOPEN;
+
+		std::memcpy(zOut, zName, (len + 1));
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::DlOpen(sqlite3_vfs* pVfs, const char* zFilename) -> void* {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return pBase->xDlOpen(pBase, zFilename);
+	}
+
+	inline auto MemoryVfs::DlError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> void {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		pBase->xDlError(pBase, nByte, zErrMsg);
+	}
+
+	inline auto MemoryVfs::DlSym(sqlite3_vfs* pVfs, void* pHandle, const char* zSymbol) -> void (*)(void) {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return pBase->xDlSym(pBase, pHandle, zSymbol);
+	}
+
+	inline auto MemoryVfs::DlClose(sqlite3_vfs* pVfs, void* pHandle) -> void {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		pBase->xDlClose(pBase, pHandle);
+	}
+
+	inline auto MemoryVfs::Randomness(sqlite3_vfs* pVfs, int nByte, char* zOut) -> int {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return pBase->xRandomness(pBase, nByte, zOut);
+	}
+
+	inline auto MemoryVfs::Sleep(sqlite3_vfs* pVfs, int microseconds) -> int {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return pBase->xSleep(pBase, microseconds);
+	}
+
+	inline auto MemoryVfs::CurrentTime(sqlite3_vfs* pVfs, double* pTime) -> int {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return pBase->xCurrentTime(pBase, pTime);
+	}
+
+	inline auto MemoryVfs::GetLastError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> int {
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		return ((pBase->xGetLastError != nullptr) ? pBase->xGetLastError(pBase, nByte, zErrMsg) : 0);
+	}
+
+	inline auto MemoryVfs::CurrentTimeInt64(sqlite3_vfs* pVfs, sqlite3_int64* pTime) -> int {
+
+		sqlite3_vfs* const pBase = MemoryVfs::Self(pVfs)->m_pBase;
+		if ((pBase->iVersion >= 2) && (pBase->xCurrentTimeInt64 != nullptr))
+			return pBase->xCurrentTimeInt64(pBase, pTime);
+
+		double time = 0.0;
+		const int res = pBase->xCurrentTime(pBase, &time);
+		*pTime = static_cast<sqlite3_int64>(time * 86400000.0);
+
+		return res;
+	}
+
+	inline auto MemoryVfs::Close(sqlite3_file* pFile) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		MemoryVfs* const pSelf = p->pVfs;
+
+		MemoryVfs::Unlock(pFile, SQLITE_LOCK_NONE);
+
+		const std::string name = std::move(p->name);
+		p->~File();
+
+		if (!name.empty()) {
+			std::lock_guard<std::mutex> lock(pSelf->m_filesMutex);
+			const auto it = pSelf->m_files.find(name);
+			if ((it != pSelf->m_files.end()) && it->second.expired())
+				pSelf->m_files.erase(it);
+		}
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Read(sqlite3_file* pFile, void* pBuf, int amount, sqlite3_int64 offset) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		Storage& storage = *p->storage;
+
+		std::lock_guard<std::mutex> lock(storage.mutex);
+
+		const std::size_t requested = static_cast<std::size_t>(amount);
+		const std::size_t available = ((offset < storage.size) ? static_cast<std::size_t>(storage.size - offset) : 0);
+		const std::size_t len = std::min(requested, available);
+
+		if (len > 0) p->pVfs->Copy(storage, pBuf, len, offset);
+
+		if (len < requested) {
+			std::memset((static_cast<std::byte*>(pBuf) + len), 0, (requested - len));
+			return SQLITE_IOERR_SHORT_READ;
+		}
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Write(sqlite3_file* pFile, const void* pBuf, int amount, sqlite3_int64 offset) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		MemoryVfs* const pSelf = p->pVfs;
+		Storage& storage = *p->storage;
+
+		std::lock_guard<std::mutex> lock(storage.mutex);
+
+		const std::size_t end = static_cast<std::size_t>(offset + amount);
+		if ((pSelf->m_options.maxFileSize != 0) && (end > pSelf->m_options.maxFileSize))
+			return SQLITE_FULL;
+
+		const std::size_t chunkSize = pSelf->m_options.chunkSize;
+		const std::size_t needed = ((end + chunkSize - 1) / chunkSize);
+
+		try {
+			while (storage.chunks.size() < needed) {
+				Chunk chunk = pSelf->AcquireChunk();
+				if (!chunk) return SQLITE_NOMEM;
+				storage.chunks.push_back(std::move(chunk));
+			}
+		}
+		catch (const std::bad_alloc&) {
+			return SQLITE_NOMEM;
+		}
+
+		if (offset > storage.size)
+			pSelf->Fill(storage, nullptr, static_cast<std::size_t>(offset - storage.size), storage.size);
+
+		pSelf->Fill(storage, pBuf, static_cast<std::size_t>(amount), offset);
+		storage.size = std::max(storage.size, static_cast<sqlite3_int64>(end));
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Truncate(sqlite3_file* pFile, sqlite3_int64 size) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		MemoryVfs* const pSelf = p->pVfs;
+		Storage& storage = *p->storage;
+
+		std::lock_guard<std::mutex> lock(storage.mutex);
+
+		if (size < storage.size) {
+			const std::size_t chunkSize = pSelf->m_options.chunkSize;
+			pSelf->RecycleChunks(storage.chunks, ((static_cast<std::size_t>(size) + chunkSize - 1) / chunkSize));
+			storage.size = size;
+		}
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Sync(sqlite3_file*, int) -> int {
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::FileSize(sqlite3_file* pFile, sqlite3_int64* pSize) -> int {
+
+		Storage& storage = *reinterpret_cast<File*>(pFile)->storage;
+
+		std::lock_guard<std::mutex> lock(storage.mutex);
+		*pSize = storage.size;
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Lock(sqlite3_file* pFile, int lock) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		Storage& storage = *p->storage;
+
+		std::lock_guard<std::mutex> guard(storage.mutex);
+
+		if (p->lock >= lock) return SQLITE_OK;
+
+		if (lock == SQLITE_LOCK_SHARED) {
+			if (storage.pending || storage.exclusive) return SQLITE_BUSY;
+			++storage.sharedLocks;
+			p->lock = SQLITE_LOCK_SHARED;
+			return SQLITE_OK;
+		}
+
+		if ((storage.pWriter != nullptr) && (storage.pWriter != p)) return SQLITE_BUSY;
+		storage.pWriter = p;
+
+		if (lock == SQLITE_LOCK_RESERVED) {
+			p->lock = SQLITE_LOCK_RESERVED;
+			return SQLITE_OK;
+		}
+
+		storage.pending = true;
+		if (storage.sharedLocks > 1) {
+			p->lock = SQLITE_LOCK_PENDING;
+			return SQLITE_BUSY;
+		}
+
+		storage.exclusive = true;
+		p->lock = SQLITE_LOCK_EXCLUSIVE;
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::Unlock(sqlite3_file* pFile, int lock) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+		Storage& storage = *p->storage;
+
+		std::lock_guard<std::mutex> guard(storage.mutex);
+
+		if (p->lock <= lock) return SQLITE_OK;
+
+		if ((p->lock > SQLITE_LOCK_SHARED) && (storage.pWriter == p)) {
+			storage.pWriter = nullptr;
+			storage.pending = false;
+			storage.exclusive = false;
+		}
+
+		if ((lock == SQLITE_LOCK_NONE) && (p->lock >= SQLITE_LOCK_SHARED))
+			--storage.sharedLocks;
+
+		p->lock = lock;
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::CheckReservedLock(sqlite3_file* pFile, int* pResOut) -> int {
+
+		Storage& storage = *reinterpret_cast<File*>(pFile)->storage;
+
+		std::lock_guard<std::mutex> lock(storage.mutex);
+		*pResOut = ((storage.pWriter != nullptr) ? 1 : 0);
+
+		return SQLITE_OK;
+	}
+
+	inline auto MemoryVfs::FileControl(sqlite3_file* pFile, int op, void* pArg) -> int {
+
+		if (op == SQLITE_FCNTL_VFSNAME) {
+			const MemoryVfs* const pSelf = reinterpret_cast<File*>(pFile)->pVfs;
+			*static_cast<char**>(pArg) = sqlite3_mprintf("%s", pSelf->m_name.c_str());
+			return SQLITE_OK;
+		}
+
+		return SQLITE_NOTFOUND;
+	}
+
+	inline auto MemoryVfs::SectorSize(sqlite3_file*) -> int {
+		return 1024;
+	}
+
+	inline auto MemoryVfs::DeviceCharacteristics(sqlite3_file*) -> int {
+		return (SQLITE_IOCAP_POWERSAFE_OVERWRITE | SQLITE_IOCAP_SAFE_APPEND | SQLITE_IOCAP_SEQUENTIAL);
+	}
+
+}
+
+#endif // __VSQLITE3_MEMORYVFS_HPP__
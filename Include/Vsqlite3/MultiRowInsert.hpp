@@ -0,0 +1,127 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_MULTIROWINSERT_HPP__
+#define __VSQLITE3_MULTIROWINSERT_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	// Builds and caches "INSERT INTO t (...) VALUES (...), (...), ..." statements, one per row count.
+	// The rows per statement are clamped so the parameters never exceed SQLITE_LIMIT_VARIABLE_NUMBER.
+	// Without a schema the table name is left unqualified and resolved the way SQLite resolves it.
+
+	class MultiRowInsert {
+
+	public:
+		MultiRowInsert(Database& db, const std::string_view table, const std::vector<std::string>& columns, const std::size_t rowsPerStatement, const std::optional<std::string_view> returning = std::nullopt, const std::optional<std::string_view> schema = std::nullopt);
+
+		auto RowsPerStatement(void) const -> std::size_t;
+		auto Prepare(const std::size_t rows) -> Statement&;
+		auto Clear(void) -> void;
+
+		template <typename... Columns>
+		static auto BindRows(sqlite3_stmt* const pStmt, const std::span<const std::tuple<Columns...>> rows) -> void;
+
+	private:
+		Database* m_pDb;
+		std::string m_insert;
+		std::string m_values;
+		std::string m_suffix;
+		std::size_t m_rowsPerStatement;
+		std::map<std::size_t, Statement> m_statements;
+
+	};
+
+	inline MultiRowInsert::MultiRowInsert(Database& db, const std::string_view table, const std::vector<std::string>& columns, const std::size_t rowsPerStatement, const std::optional<std::string_view> returning, const std::optional<std::string_view> schema)
+		: m_pDb(&db) {
+
+		if (table.empty())
+			throw std::invalid_argument("'table': Empty string.");
+
+		if (columns.empty())
+			throw std::invalid_argument("'columns': No columns specified.");
+
+		if (rowsPerStatement == 0)
+			throw std::invalid_argument("'rowsPerStatement': Rows per statement cannot be zero.");
+
+		if (schema.has_value() && schema->empty())
+			throw std::invalid_argument("'schema': Empty string.");
+
+		this->m_insert = "INSERT INTO ";
+		if (schema.has_value()) this->m_insert += (QuoteIdentifier(schema.value()) + ".");
+		this->m_insert += (QuoteIdentifier(table) + " (");
+		for (std::size_t i = 0; i < columns.size(); ++i)
+			this->m_insert += ((i == 0) ? "" : ", ") + QuoteIdentifier(columns[i]);
+		this->m_insert += ") VALUES ";
+
+		this->m_values = "(";
+		for (std::size_t i = 0; i < columns.size(); ++i)
+			this->m_values += ((i == 0) ? "?" : ", ?");
+		this->m_values += ")";
+
+		this->m_suffix = (returning.has_value() ? (" RETURNING " + std::string(returning.value()) + ";") : ";");
+
+		const std::size_t maxVariables = static_cast<std::size_t>(sqlite3_limit(db.ConnectionHandle(), SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+		this->m_rowsPerStatement = std::max<std::size_t>(1, std::min(rowsPerStatement, (maxVariables / columns.size())));
+
+	}
+
+	inline auto MultiRowInsert::RowsPerStatement() const -> std::size_t {
+		return this->m_rowsPerStatement;
+	}
+
+	inline auto MultiRowInsert::Prepare(const std::size_t rows) -> Statement& {
+
+		auto it = this->m_statements.find(rows);
+		if (it != this->m_statements.end()) return it->second;
+
+		std::string sql = this->m_insert;
+		for (std::size_t i = 0; i < rows; ++i)
+			sql += ((i == 0) ? "" : ", ") + this->m_values;
+		sql += this->m_suffix;
+
+		return this->m_statements.try_emplace(rows, *this->m_pDb, sql).first->second;
+	}
+
+	inline auto MultiRowInsert::Clear() -> void {
+		this->m_statements.clear();
+	}
+
+	template <typename... Columns>
+	inline auto MultiRowInsert::BindRows(sqlite3_stmt* const pStmt, const std::span<const std::tuple<Columns...>> rows) -> void {
+
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+
+			const int first = static_cast<int>((i * sizeof...(Columns)) + 1);
+
+			std::apply([pStmt, first](const Columns&... values) {
+				int index = first;
+				([&] {
+					const int res = Binding<Columns>::Bind(pStmt, index++, values);
+					if (res != SQLITE_OK) throw SqliteException { pStmt };
+				}(), ...);
+			}, rows[i]);
+
+		}
+
+	}
+
+}
+
+#endif // __VSQLITE3_MULTIROWINSERT_HPP__
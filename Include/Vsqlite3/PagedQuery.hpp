@@ -0,0 +1,410 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_PAGEDQUERY_HPP__
+#define __VSQLITE3_PAGEDQUERY_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <charconv>
+#include <type_traits>
+#include <cctype>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	// 'Params' are the types of the base query's own parameters. Their values are stored and bound
+	// to every page ahead of the key and LIMIT parameters, so they must own their data (std::string
+	// rather than std::string_view). Key columns cannot be NULL: row-value comparisons with NULL are
+	// never true, so paging would stop at the first NULL key.
+
+	template <typename Key, typename Row, typename Params = std::tuple<>>
+	class PagedQuery;
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	class PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>> {
+
+	public:
+		using Key = std::tuple<Keys...>;
+		using Row = std::tuple<Columns...>;
+		using Parameters = std::tuple<Params...>;
+
+		PagedQuery(const Database& db, const std::string_view query, const std::vector<std::string>& keyColumns, const std::size_t pageSize, const bool descending = false, Parameters params = { });
+
+		auto NextPage(void) -> std::vector<Row>;
+		auto HasMore(void) const -> bool;
+		auto Rewind(void) -> void;
+
+		auto Token(void) const -> std::string;
+		auto Resume(const std::string_view token) -> void;
+
+	private:
+		Statement m_first;
+		Statement m_next;
+		Parameters m_params;
+		std::size_t m_pageSize;
+		std::array<int, sizeof...(Keys)> m_keyIndices;
+		std::optional<Key> m_lastKey;
+		std::uint64_t m_fingerprint;
+		bool m_done;
+
+		template <typename T>
+		struct IsNullable : std::false_type { };
+
+		template <typename T>
+		struct IsNullable<std::optional<T>> : std::true_type { };
+
+		auto Fetch(Statement& stmt) -> std::vector<Row>;
+
+		static auto BuildQuery(const std::string_view query, const std::vector<std::string>& keyColumns, const bool descending, const bool after) -> std::string;
+		static auto Fingerprint(const std::string_view text) -> std::uint64_t;
+
+		template <typename T>
+		static auto Encode(std::string& out, const T& value) -> void;
+
+		template <typename T>
+		static auto Decode(std::string_view& in, T& value) -> void;
+
+		static auto EncodeBase64(const std::string_view data) -> std::string;
+		static auto DecodeBase64(const std::string_view text) -> std::string;
+
+	};
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::PagedQuery(const Database& db, const std::string_view query, const std::vector<std::string>& keyColumns, const std::size_t pageSize, const bool descending, Parameters params)
+		: m_first(db, BuildQuery(query, keyColumns, descending, false)),
+		  m_next(db, BuildQuery(query, keyColumns, descending, true)),
+		  m_params(std::move(params)), m_pageSize(pageSize), m_keyIndices { }, m_done(false) {
+
+		static_assert((sizeof...(Keys) > 0), "At least one key type must be specified.");
+		static_assert((sizeof...(Columns) > 0), "At least one column type must be specified.");
+		static_assert((!IsNullable<Keys>::value && ...), "Key columns cannot be nullable.");
+
+		if (sqlite3_bind_parameter_count(this->m_first.StatementHandle()) != static_cast<int>(sizeof...(Params) + 1))
+			throw std::invalid_argument("'params': Parameter count does not match the query.");
+
+		if (pageSize == 0)
+			throw std::invalid_argument("'pageSize': Page size cannot be zero.");
+
+		if (keyColumns.size() != sizeof...(Keys))
+			throw std::invalid_argument("'keyColumns': Column count does not match the key types.");
+
+		sqlite3_stmt* const pStmt = this->m_first.StatementHandle();
+		const int columns = sqlite3_column_count(pStmt);
+
+		if (columns < static_cast<int>(sizeof...(Columns)))
+			throw std::invalid_argument("'query': Query returns fewer columns than the row type.");
+
+		for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+
+			const std::string_view key = keyColumns[i];
+			this->m_keyIndices[i] = -1;
+
+			for (int column = 0; column < columns; ++column) {
+
+				const std::string_view name = sqlite3_column_name(pStmt, column);
+				const bool same = std::equal(name.begin(), name.end(), key.begin(), key.end(), [](const unsigned char a, const unsigned char b) {
+					return (std::tolower(a) == std::tolower(b));
+				});
+
+				if (same) {
+					this->m_keyIndices[i] = column;
+					break;
+				}
+
+			}
+
+			if (this->m_keyIndices[i] < 0)
+				throw std::invalid_argument("'keyColumns': Key column '" + keyColumns[i] + "' is not returned by the query.");
+
+		}
+
+		this->m_fingerprint = PagedQuery::Fingerprint(BuildQuery(query, keyColumns, descending, true));
+
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::NextPage() -> std::vector<Row> {
+
+		if (this->m_done) return { };
+
+		if (!this->m_lastKey.has_value()) {
+			this->m_first.Reset();
+			std::apply([this](const Params&... params) {
+				this->m_first.Bind(params..., static_cast<sqlite3_int64>(this->m_pageSize));
+			}, this->m_params);
+			return this->Fetch(this->m_first);
+		}
+
+		this->m_next.Reset();
+		std::apply([this](const Params&... params) {
+			std::apply([this, &params...](const Keys&... keys) {
+				this->m_next.Bind(params..., keys..., static_cast<sqlite3_int64>(this->m_pageSize));
+			}, this->m_lastKey.value());
+		}, this->m_params);
+
+		return this->Fetch(this->m_next);
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::HasMore() const -> bool {
+		return !this->m_done;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Rewind() -> void {
+		this->m_lastKey.reset();
+		this->m_done = false;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Token() const -> std::string {
+
+		std::string data;
+		PagedQuery::Encode(data, this->m_fingerprint);
+		data.push_back(this->m_done ? 'D' : (this->m_lastKey.has_value() ? 'K' : 'S'));
+
+		if (this->m_lastKey.has_value())
+			std::apply([&data](const Keys&... keys) { (PagedQuery::Encode(data, keys), ...); }, this->m_lastKey.value());
+
+		return PagedQuery::EncodeBase64(data);
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Resume(const std::string_view token) -> void {
+
+		const std::string data = PagedQuery::DecodeBase64(token);
+		std::string_view in = data;
+
+		std::uint64_t fingerprint = 0;
+		PagedQuery::Decode(in, fingerprint);
+
+		if (fingerprint != this->m_fingerprint)
+			throw std::invalid_argument("'token': Token was issued for a different query.");
+
+		if (in.empty())
+			throw std::invalid_argument("'token': Malformed token.");
+
+		const char state = in.front();
+		in.remove_prefix(1);
+
+		std::optional<Key> lastKey;
+		if (state == 'K') std::apply([&in](Keys&... keys) { (PagedQuery::Decode(in, keys), ...); }, lastKey.emplace());
+		else if ((state != 'S') && (state != 'D')) throw std::invalid_argument("'token': Malformed token.");
+
+		if (!in.empty())
+			throw std::invalid_argument("'token': Malformed token.");
+
+		this->m_lastKey = std::move(lastKey);
+		this->m_done = (state == 'D');
+
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Fetch(Statement& stmt) -> std::vector<Row> {
+
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+
+		std::vector<Row> rows;
+		rows.reserve(this->m_pageSize);
+
+		Key key;
+
+		try {
+
+			stmt.Step();
+			while (sqlite3_data_count(pStmt) > 0) {
+
+				Row& row = rows.emplace_back();
+				[&]<std::size_t... I>(std::index_sequence<I...>) {
+					(Binding<Columns>::Column(pStmt, static_cast<int>(I), std::get<I>(row)), ...);
+				}(std::index_sequence_for<Columns...> { });
+
+				if (rows.size() == this->m_pageSize) {
+					[&]<std::size_t... I>(std::index_sequence<I...>) {
+						(Binding<Keys>::Column(pStmt, this->m_keyIndices[I], std::get<I>(key)), ...);
+					}(std::index_sequence_for<Keys...> { });
+				}
+
+				stmt.Step();
+
+			}
+
+		}
+		catch (...) {
+			sqlite3_reset(pStmt);
+			throw;
+		}
+
+		stmt.Reset();
+
+		if (rows.size() < this->m_pageSize) this->m_done = true;
+		else this->m_lastKey = std::move(key);
+
+		return rows;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::BuildQuery(const std::string_view query, const std::vector<std::string>& keyColumns, const bool descending, const bool after) -> std::string {
+
+		std::string_view base = query;
+		while (!base.empty() && ((base.back() == ';') || std::isspace(static_cast<unsigned char>(base.back()))))
+			base.remove_suffix(1);
+
+		if (base.empty())
+			throw std::invalid_argument("'query': Empty string.");
+
+		if (keyColumns.empty())
+			throw std::invalid_argument("'keyColumns': At least one key column must be specified.");
+
+		std::string keys;
+		std::string params;
+		std::string order;
+
+		for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+			keys += ((i == 0) ? "" : ", ") + QuoteIdentifier(keyColumns[i]);
+			params += ((i == 0) ? "?" : ", ?");
+			order += ((i == 0) ? "" : ", ") + QuoteIdentifier(keyColumns[i]) + (descending ? " DESC" : " ASC");
+		}
+
+		std::string sql = ("SELECT * FROM (" + std::string(base) + ")");
+		if (after) sql += (" WHERE (" + keys + ") " + (descending ? "<" : ">") + " (" + params + ")");
+		sql += (" ORDER BY " + order + " LIMIT ?;");
+
+		return sql;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Fingerprint(const std::string_view text) -> std::uint64_t {
+
+		std::uint64_t hash = 0xCBF29CE484222325ull;
+		for (const char ch : text) {
+			hash ^= static_cast<unsigned char>(ch);
+			hash *= 0x100000001B3ull;
+		}
+
+		return hash;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	template <typename T>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Encode(std::string& out, const T& value) -> void {
+
+		if constexpr (std::is_same_v<T, std::string>) {
+			Encode(out, static_cast<std::uint64_t>(value.size()));
+			out += value;
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			char buffer[32] = { };
+			const auto res = std::to_chars(std::begin(buffer), std::end(buffer), value);
+			out.append(buffer, res.ptr);
+			out.push_back(';');
+		}
+		else static_assert(!sizeof(T), "Key type cannot be stored in a token.");
+
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	template <typename T>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::Decode(std::string_view& in, T& value) -> void {
+
+		if constexpr (std::is_same_v<T, std::string>) {
+
+			std::uint64_t size = 0;
+			Decode(in, size);
+
+			if (size > in.size())
+				throw std::invalid_argument("'token': Malformed token.");
+
+			value.assign(in.data(), static_cast<std::size_t>(size));
+			in.remove_prefix(static_cast<std::size_t>(size));
+
+		}
+		else {
+
+			const auto [ptr, ec] = std::from_chars(in.data(), (in.data() + in.size()), value);
+			if ((ec != std::errc { }) || (ptr == (in.data() + in.size())) || (*ptr != ';'))
+				throw std::invalid_argument("'token': Malformed token.");
+
+			in.remove_prefix(static_cast<std::size_t>(ptr - in.data()) + 1);
+
+		}
+
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::EncodeBase64(const std::string_view data) -> std::string {
+
+		constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+		std::string text;
+		text.reserve(((data.size() + 2) / 3) * 4);
+
+		for (std::size_t i = 0; i < data.size(); i += 3) {
+
+			const std::size_t count = std::min<std::size_t>(3, (data.size() - i));
+
+			std::uint32_t bits = (static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << 16);
+			if (count > 1) bits |= (static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 1])) << 8);
+			if (count > 2) bits |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 2]));
+
+			for (std::size_t j = 0; j <= count; ++j)
+				text.push_back(alphabet[(bits >> (18 - (6 * j))) & 0x3F]);
+
+		}
+
+		return text;
+	}
+
+	template <typename... Keys, typename... Columns, typename... Params>
+	inline auto PagedQuery<std::tuple<Keys...>, std::tuple<Columns...>, std::tuple<Params...>>::DecodeBase64(const std::string_view text) -> std::string {
+
+		const auto value = [](const char ch) -> int {
+			if ((ch >= 'A') && (ch <= 'Z')) return (ch - 'A');
+			if ((ch >= 'a') && (ch <= 'z')) return (ch - 'a' + 26);
+			if ((ch >= '0') && (ch <= '9')) return (ch - '0' + 52);
+			if (ch == '-') return 62;
+			if (ch == '_') return 63;
+			throw std::invalid_argument("'token': Malformed token.");
+		};
+
+		if ((text.size() % 4) == 1)
+			throw std::invalid_argument("'token': Malformed token.");
+
+		std::string data;
+		data.reserve((text.size() * 3) / 4);
+
+		std::uint32_t bits = 0;
+		int count = 0;
+
+		for (const char ch : text) {
+
+			bits = ((bits << 6) | static_cast<std::uint32_t>(value(ch)));
+			count += 6;
+
+			if (count >= 8) {
+				count -= 8;
+				data.push_back(static_cast<char>((bits >> count) & 0xFF));
+			}
+
+		}
+
+		return data;
+	}
+
+}
+
+#endif // __VSQLITE3_PAGEDQUERY_HPP__
@@ -0,0 +1,313 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_QUERYCACHE_HPP__
+#define __VSQLITE3_QUERYCACHE_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/RowCodec.hpp>
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <tuple>
+#include <list>
+#include <unordered_map>
+#include <typeindex>
+#include <typeinfo>
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	// Only read-only statements run outside a transaction are cached. Writes made through this
+	// connection are tracked with the update hook; writes the hook does not report (WITHOUT ROWID
+	// tables, REPLACE conflict deletes, ...) are caught by comparing sqlite3_total_changes64() with
+	// the number of events received, which clears the whole cache. Incremental blob I/O changes
+	// neither, so call Invalidate() after Blob::Write(). Preparing a statement installs a temporary
+	// authorizer and removes it afterwards, which also removes any authorizer the application set.
+	// Results are keyed by the SQL text and the exact bound values (see RowCodec.hpp); queries with
+	// arguments RowCodec cannot encode are run but not cached. At most 'maxEntries' results and
+	// 'maxEntries' prepared statements are kept, each evicted least recently used first.
+
+	class QueryCache {
+
+	public:
+		QueryCache(Database& db, const std::size_t maxEntries = 256, const bool trackExternalChanges = true);
+		QueryCache(const QueryCache&) = delete;
+		QueryCache(QueryCache&&) = delete;
+		~QueryCache(void);
+
+		auto operator= (const QueryCache&) -> QueryCache& = delete;
+		auto operator= (QueryCache&&) -> QueryCache& = delete;
+
+		template <typename... Columns, typename... Args>
+		auto Query(const std::string_view sql, const Args&... args) -> std::shared_ptr<const std::vector<std::tuple<Columns...>>>;
+
+		auto Invalidate(const std::string_view table) -> void;
+		auto Clear(void) -> void;
+		auto Size(void) const -> std::size_t;
+
+	private:
+		using Tables = std::vector<std::string>;
+
+		struct Prepared {
+			std::list<std::string>::iterator position;
+			Statement stmt;
+			std::shared_ptr<const Tables> tables;
+		};
+
+		struct Entry {
+			std::list<std::string>::iterator position;
+			std::type_index type;
+			std::shared_ptr<const void> rows;
+			std::shared_ptr<const Tables> tables;
+		};
+
+		Database* m_pDb;
+		std::size_t m_maxEntries;
+		std::uint64_t m_subscription;
+		std::optional<DataVersionWatcher> m_dataVersion;
+		sqlite3_int64 m_totalChanges;
+		sqlite3_int64 m_events;
+
+		std::unordered_map<std::string, Prepared> m_statements;
+		std::list<std::string> m_recentStatements;
+		std::unordered_map<std::string, Entry> m_entries;
+		std::list<std::string> m_recent;
+
+		auto Prepare(const std::string_view sql) -> Prepared&;
+		auto Reconcile(void) -> void;
+		auto Store(std::string key, const std::type_index type, std::shared_ptr<const void> rows, std::shared_ptr<const Tables> tables) -> void;
+		auto OnChanges(const std::span<const ChangeEvent> events) -> void;
+
+		static auto Normalize(const std::string_view table) -> std::string;
+		static auto OnAuthorize(void* pCtx, int action, const char* zArg1, const char* zArg2, const char* zSchema, const char* zTrigger) -> int;
+
+	};
+
+	inline QueryCache::QueryCache(Database& db, const std::size_t maxEntries, const bool trackExternalChanges)
+		: m_pDb(&db), m_maxEntries(maxEntries), m_subscription(0), m_totalChanges(db.TotalChanges()), m_events(0) {
+
+		if (maxEntries == 0)
+			throw std::invalid_argument("'maxEntries': Cache must hold at least one entry.");
+
+		if (trackExternalChanges)
+			this->m_dataVersion.emplace(db);
+
+		this->m_subscription = db.Subscribe(std::nullopt, std::nullopt, [this](const std::span<const ChangeEvent> events) {
+			this->OnChanges(events);
+		});
+
+	}
+
+	inline QueryCache::~QueryCache() {
+		this->m_pDb->Unsubscribe(this->m_subscription);
+	}
+
+	template <typename... Columns, typename... Args>
+	inline auto QueryCache::Query(const std::string_view sql, const Args&... args) -> std::shared_ptr<const std::vector<std::tuple<Columns...>>> {
+
+		static_assert((sizeof...(Columns) > 0), "At least one column type must be specified.");
+
+		using Row = std::tuple<Columns...>;
+		using Rows = std::vector<Row>;
+
+		this->m_pDb->DispatchChanges();
+		if (this->m_dataVersion.has_value() && this->m_dataVersion->HasChanged())
+			this->Clear();
+
+		Prepared& prepared = this->Prepare(sql);
+		Statement& stmt = prepared.stmt;
+
+		stmt.Reset();
+		stmt.Unbind();
+		if constexpr (sizeof...(Args) > 0) stmt.Bind(args...);
+
+		constexpr bool encodable = (RowEncodable<Args> && ...);
+
+		const bool cacheable = (encodable && (sqlite3_get_autocommit(this->m_pDb->ConnectionHandle()) != 0) && (sqlite3_stmt_readonly(stmt.StatementHandle()) != 0));
+		if (cacheable) this->Reconcile();
+
+		// The key is the SQL text followed by the arguments encoded as a row, so values that print
+		// the same (1.0 and 1.0000000000000002, 1 and '1') still get separate entries.
+
+		std::string key;
+		if (cacheable) {
+
+			key.assign(sql.begin(), sql.end());
+			key.push_back('\0');
+
+			if constexpr (encodable && (sizeof...(Args) > 0))
+				EncodeValues(key, args...);
+
+		}
+
+		if (!key.empty()) {
+
+			const auto it = this->m_entries.find(key);
+			if ((it != this->m_entries.end()) && (it->second.type == std::type_index(typeid(Rows)))) {
+				this->m_recent.splice(this->m_recent.begin(), this->m_recent, it->second.position);
+				return std::static_pointer_cast<const Rows>(it->second.rows);
+			}
+
+		}
+
+		auto rows = std::make_shared<Rows>();
+		Row row;
+
+		try {
+			while (std::apply([&stmt](auto&... columns) { return stmt.Fetch(columns...); }, row))
+				rows->push_back(row);
+		}
+		catch (...) {
+			stmt.Reset();
+			throw;
+		}
+
+		stmt.Reset();
+
+		if (!key.empty())
+			this->Store(std::move(key), std::type_index(typeid(Rows)), rows, prepared.tables);
+
+		return rows;
+	}
+
+	inline auto QueryCache::Invalidate(const std::string_view table) -> void {
+
+		const std::string name = QueryCache::Normalize(table);
+
+		for (auto it = this->m_entries.begin(); it != this->m_entries.end(); ) {
+
+			const Tables& tables = *it->second.tables;
+			if (std::find(tables.begin(), tables.end(), name) != tables.end()) {
+				this->m_recent.erase(it->second.position);
+				it = this->m_entries.erase(it);
+			}
+			else ++it;
+
+		}
+
+	}
+
+	inline auto QueryCache::Clear() -> void {
+		this->m_entries.clear();
+		this->m_recent.clear();
+	}
+
+	inline auto QueryCache::Size() const -> std::size_t {
+		return this->m_entries.size();
+	}
+
+	inline auto QueryCache::Prepare(const std::string_view sql) -> Prepared& {
+
+		std::string text { sql };
+
+		const auto it = this->m_statements.find(text);
+		if (it != this->m_statements.end()) {
+			this->m_recentStatements.splice(this->m_recentStatements.begin(), this->m_recentStatements, it->second.position);
+			return it->second;
+		}
+
+		auto tables = std::make_shared<Tables>();
+		sqlite3* const pDb = this->m_pDb->ConnectionHandle();
+
+		sqlite3_set_authorizer(pDb, &QueryCache::OnAuthorize, tables.get());
+
+		std::optional<Statement> stmt;
+		try { stmt.emplace(*this->m_pDb, sql); }
+		catch (...) {
+			sqlite3_set_authorizer(pDb, nullptr, nullptr);
+			throw;
+		}
+
+		sqlite3_set_authorizer(pDb, nullptr, nullptr);
+
+		while (!this->m_recentStatements.empty() && (this->m_statements.size() >= this->m_maxEntries)) {
+			this->m_statements.erase(this->m_recentStatements.back());
+			this->m_recentStatements.pop_back();
+		}
+
+		this->m_recentStatements.push_front(text);
+		return this->m_statements.emplace(std::move(text), Prepared { this->m_recentStatements.begin(), std::move(stmt.value()), std::move(tables) }).first->second;
+	}
+
+	inline auto QueryCache::Reconcile() -> void {
+
+		// Every row change counted by sqlite3_total_changes64() should have arrived as an event.
+		// A mismatch means something changed that the update hook did not see; it is not known
+		// which tables were affected, so everything goes.
+
+		const sqlite3_int64 totalChanges = this->m_pDb->TotalChanges();
+		if ((totalChanges - this->m_totalChanges) != this->m_events)
+			this->Clear();
+
+		this->m_totalChanges = totalChanges;
+		this->m_events = 0;
+
+	}
+
+	inline auto QueryCache::Store(std::string key, const std::type_index type, std::shared_ptr<const void> rows, std::shared_ptr<const Tables> tables) -> void {
+
+		const auto existing = this->m_entries.find(key);
+		if (existing != this->m_entries.end()) {
+			this->m_recent.erase(existing->second.position);
+			this->m_entries.erase(existing);
+		}
+
+		while (this->m_entries.size() >= this->m_maxEntries) {
+			this->m_entries.erase(this->m_recent.back());
+			this->m_recent.pop_back();
+		}
+
+		this->m_recent.push_front(key);
+		this->m_entries.emplace(std::move(key), Entry { this->m_recent.begin(), type, std::move(rows), std::move(tables) });
+
+	}
+
+	inline auto QueryCache::OnChanges(const std::span<const ChangeEvent> events) -> void {
+
+		this->m_events += static_cast<sqlite3_int64>(events.size());
+
+		std::string previous;
+		for (const ChangeEvent& event : events) {
+			if (event.table == previous) continue;
+			previous = event.table;
+			this->Invalidate(event.table);
+		}
+
+	}
+
+	inline auto QueryCache::Normalize(const std::string_view table) -> std::string {
+
+		std::string name { table };
+		std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+
+		return name;
+	}
+
+	inline auto QueryCache::OnAuthorize(void* pCtx, int action, const char* zArg1, const char*, const char*, const char*) -> int {
+
+		if ((action == SQLITE_READ) && (zArg1 != nullptr)) {
+
+			Tables* const pTables = static_cast<Tables*>(pCtx);
+			std::string name = QueryCache::Normalize(zArg1);
+
+			if (std::find(pTables->begin(), pTables->end(), name) == pTables->end())
+				pTables->push_back(std::move(name));
+
+		}
+
+		return SQLITE_OK;
+	}
+
+}
+
+#endif // __VSQLITE3_QUERYCACHE_HPP__
@@ -0,0 +1,1079 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_QUERYSERVER_HPP__
+#define __VSQLITE3_QUERYSERVER_HPP__
+
+#if defined(_WIN32)
+#error "QueryServer.hpp requires Unix domain sockets and POSIX shared memory."
+#endif
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/RowCodec.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+namespace Vsqlite3 {
+
+	struct QueryServerOptions {
+		std::size_t connections = 4;
+		std::size_t statementCacheSize = 64;
+		std::size_t ringSize = (4 * 1024 * 1024);
+		std::size_t batchSize = (64 * 1024);
+		std::size_t maxRequestSize = (16 * 1024 * 1024);
+		std::chrono::milliseconds consumeTimeout = std::chrono::seconds(30);
+	};
+
+	enum class QueryMessage : std::uint32_t {
+		Hello = 1,
+		Query = 2,
+		Consumed = 3,
+		Batch = 4,
+		Done = 5,
+		Error = 6,
+	};
+
+	class QueryChannel {
+
+	public:
+		explicit QueryChannel(const int socket);
+		QueryChannel(const QueryChannel&) = delete;
+		QueryChannel(QueryChannel&& other) noexcept;
+		~QueryChannel(void);
+
+		auto operator= (const QueryChannel&) -> QueryChannel& = delete;
+
+		auto Send(const QueryMessage type, const std::span<const char> payload, const int descriptor = -1) -> void;
+		auto Receive(QueryMessage& type, std::string& payload, const std::size_t maxSize, int* const pDescriptor = nullptr) -> bool;
+		auto Wait(const std::chrono::milliseconds timeout) -> bool;
+		auto Shutdown(void) -> void;
+
+	private:
+		int m_socket;
+
+		auto ReceiveBytes(char* pData, std::size_t size, int* const pDescriptor) -> std::size_t;
+
+	};
+
+	class SharedMapping {
+
+	public:
+		SharedMapping(const int descriptor, const std::size_t size, const bool writable);
+		SharedMapping(const SharedMapping&) = delete;
+		SharedMapping(SharedMapping&& other) noexcept;
+		~SharedMapping(void);
+
+		auto operator= (const SharedMapping&) -> SharedMapping& = delete;
+
+		auto Data(void) const -> char*;
+		auto Size(void) const -> std::size_t;
+
+	private:
+		char* m_pData;
+		std::size_t m_size;
+
+	};
+
+	class QueryServer {
+
+	public:
+		QueryServer(const std::filesystem::path& socketPath, std::function<Database(void)> connect, const QueryServerOptions& options = { });
+		QueryServer(const QueryServer&) = delete;
+		~QueryServer(void);
+
+		auto operator= (const QueryServer&) -> QueryServer& = delete;
+
+		auto Stop(void) -> void;
+
+	private:
+		struct CachedStatement {
+			std::list<std::string>::iterator position;
+			Statement stmt;
+		};
+
+		struct Connection {
+			Database db;
+			std::unordered_map<std::string, CachedStatement> statements;
+			std::list<std::string> recent;
+		};
+
+		struct Session {
+			QueryChannel channel;
+			std::atomic<bool> finished;
+			std::jthread thread;
+
+			explicit Session(const int socket) : channel(socket), finished(false) { }
+		};
+
+		struct Ring {
+			SharedMapping mapping;
+			std::uint64_t head;
+			std::uint64_t tail;
+		};
+
+		std::filesystem::path m_path;
+		QueryServerOptions m_options;
+		int m_listener;
+		int m_wakeup[2];
+
+		std::vector<std::unique_ptr<Connection>> m_connections;
+		std::vector<Connection*> m_idle;
+		std::mutex m_poolMutex;
+		std::condition_variable m_poolSignal;
+		bool m_stopping;
+
+		std::mutex m_sessionsMutex;
+		std::list<Session> m_sessions;
+		std::jthread m_acceptor;
+
+		auto Accept(void) -> void;
+		auto Serve(Session& session) -> void;
+		auto Run(Connection& connection, QueryChannel& channel, Ring& ring, const std::string_view sql, const std::optional<RowView>& parameters) -> void;
+		auto Publish(QueryChannel& channel, Ring& ring, const std::string_view batch) -> void;
+
+		auto Acquire(void) -> Connection*;
+		auto Release(Connection* const pConnection) -> void;
+		auto Prepare(Connection& connection, const std::string_view sql) -> Statement&;
+
+		static auto CreateSharedMemory(const std::size_t size) -> int;
+
+	};
+
+	class QueryClient {
+
+	public:
+		QueryClient(const std::filesystem::path& socketPath);
+		QueryClient(const QueryClient&) = delete;
+
+		auto operator= (const QueryClient&) -> QueryClient& = delete;
+
+		template <typename... Args>
+		auto Execute(const std::string_view sql, const Args&... args) -> void;
+
+		auto Next(RowView& row) -> bool;
+
+		template <typename... Args>
+		auto Fetch(Args&... args) -> bool;
+
+		auto Changes(void) -> sqlite3_int64;
+		auto LastInsertRowId(void) -> sqlite3_int64;
+
+	private:
+		std::optional<QueryChannel> m_channel;
+		std::optional<SharedMapping> m_ring;
+		std::string m_request;
+		std::string m_message;
+		const char* m_pBatch;
+		std::size_t m_batchSize;
+		std::size_t m_offset;
+		std::uint64_t m_batchEnd;
+		bool m_unacknowledged;
+		bool m_active;
+		sqlite3_int64 m_changes;
+		sqlite3_int64 m_lastInsertRowId;
+
+		auto Acknowledge(void) -> void;
+		auto Drain(void) -> void;
+
+	};
+
+	namespace QueryProtocol {
+
+		struct Header {
+			std::uint32_t type;
+			std::uint32_t size;
+		};
+
+		template <typename T>
+		inline auto Append(std::string& out, const T value) -> void {
+			out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		template <typename T>
+		inline auto Read(const std::string_view in, const std::size_t offset) -> T {
+
+			if ((offset + sizeof(T)) > in.size())
+				throw std::runtime_error("Truncated query server message.");
+
+			T value = { };
+			std::memcpy(&value, (in.data() + offset), sizeof(T));
+
+			return value;
+		}
+
+		inline auto SetCloseOnExec(const int descriptor) -> void {
+			fcntl(descriptor, F_SETFD, (fcntl(descriptor, F_GETFD) | FD_CLOEXEC));
+		}
+
+		inline auto MakeAddress(const std::filesystem::path& path) -> sockaddr_un {
+
+			sockaddr_un address = { };
+			address.sun_family = AF_UNIX;
+
+			const std::string& native = path.native();
+			if (native.empty() || (native.size() >= sizeof(address.sun_path)))
+				throw std::invalid_argument("'socketPath': Path is empty or too long for a Unix domain socket.");
+
+			std::memcpy(address.sun_path, native.c_str(), (native.size() + 1));
+
+			return address;
+		}
+
+		inline auto OpenSocket(void) -> int {
+
+			const int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if (socket < 0)
+				throw std::system_error(errno, std::generic_category(), "socket");
+
+			SetCloseOnExec(socket);
+
+#ifdef SO_NOSIGPIPE
+			const int enable = 1;
+			setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+			return socket;
+		}
+
+	}
+
+	inline QueryChannel::QueryChannel(const int socket) : m_socket(socket) { }
+
+	inline QueryChannel::QueryChannel(QueryChannel&& other) noexcept : m_socket(std::exchange(other.m_socket, -1)) { }
+
+	inline QueryChannel::~QueryChannel() {
+		if (this->m_socket >= 0) close(this->m_socket);
+	}
+
+	inline auto QueryChannel::Send(const QueryMessage type, const std::span<const char> payload, const int descriptor) -> void {
+
+#ifdef MSG_NOSIGNAL
+		constexpr int flags = MSG_NOSIGNAL;
+#else
+		constexpr int flags = 0;
+#endif
+
+		const QueryProtocol::Header header = { static_cast<std::uint32_t>(type), static_cast<std::uint32_t>(payload.size()) };
+
+		iovec parts[2] = {
+			{ const_cast<QueryProtocol::Header*>(&header), sizeof(header) },
+			{ const_cast<char*>(payload.data()), payload.size() },
+		};
+
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = { };
+
+		msghdr message = { };
+		message.msg_iov = parts;
+		message.msg_iovlen = 2;
+
+		if (descriptor >= 0) {
+			message.msg_control = control;
+			message.msg_controllen = sizeof(control);
+			cmsghdr* const pControl = CMSG_FIRSTHDR(&message);
+			pControl->cmsg_level = SOL_SOCKET;
+			pControl->cmsg_type = SCM_RIGHTS;
+			pControl->cmsg_len = CMSG_LEN(sizeof(int));
+			std::memcpy(CMSG_DATA(pControl), &descriptor, sizeof(int));
+		}
+
+		while ((message.msg_iovlen > 0) && ((message.msg_iov[0].iov_len > 0) || (message.msg_iovlen > 1))) {
+
+			const ssize_t sent = sendmsg(this->m_socket, &message, flags);
+			if (sent < 0) {
+				if (errno == EINTR) continue;
+				throw std::system_error(errno, std::generic_category(), "sendmsg");
+			}
+
+			// The descriptor travels with the first byte, so later partial writes send only data.
+
+			message.msg_control = nullptr;
+			message.msg_controllen = 0;
+
+			std::size_t remaining = static_cast<std::size_t>(sent);
+			while ((message.msg_iovlen > 0) && (remaining >= message.msg_iov[0].iov_len)) {
+				remaining -= message.msg_iov[0].iov_len;
+				++message.msg_iov;
+				--message.msg_iovlen;
+			}
+
+			if (message.msg_iovlen > 0) {
+				message.msg_iov[0].iov_base = (static_cast<char*>(message.msg_iov[0].iov_base) + remaining);
+				message.msg_iov[0].iov_len -= remaining;
+			}
+
+		}
+
+	}
+
+	inline auto QueryChannel::Receive(QueryMessage& type, std::string& payload, const std::size_t maxSize, int* const pDescriptor) -> bool {
+
+		QueryProtocol::Header header = { };
+
+		const std::size_t received = this->ReceiveBytes(reinterpret_cast<char*>(&header), sizeof(header), pDescriptor);
+		if (received == 0) return false;
+
+		if (received != sizeof(header))
+			throw std::system_error(std::make_error_code(std::errc::connection_reset), "recv");
+
+		if (header.size > maxSize)
+			throw std::runtime_error("Query server message exceeds the size limit.");
+
+		payload.resize(header.size);
+		if (this->ReceiveBytes(payload.data(), payload.size(), nullptr) != payload.size())
+			throw std::system_error(std::make_error_code(std::errc::connection_reset), "recv");
+
+		type = static_cast<QueryMessage>(header.type);
+
+		return true;
+	}
+
+	inline auto QueryChannel::Wait(const std::chrono::milliseconds timeout) -> bool {
+
+		pollfd descriptor = { this->m_socket, POLLIN, 0 };
+
+		while (true) {
+
+			const int res = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+			if (res >= 0) return (res > 0);
+
+			if (errno != EINTR)
+				throw std::system_error(errno, std::generic_category(), "poll");
+
+		}
+
+	}
+
+	inline auto QueryChannel::Shutdown() -> void {
+		if (this->m_socket >= 0) shutdown(this->m_socket, SHUT_RDWR);
+	}
+
+	inline auto QueryChannel::ReceiveBytes(char* pData, std::size_t size, int* const pDescriptor) -> std::size_t {
+
+#ifdef MSG_CMSG_CLOEXEC
+		constexpr int flags = MSG_CMSG_CLOEXEC;
+#else
+		constexpr int flags = 0;
+#endif
+
+		std::size_t total = 0;
+		while (total < size) {
+
+			iovec part = { (pData + total), (size - total) };
+			alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = { };
+
+			msghdr message = { };
+			message.msg_iov = &part;
+			message.msg_iovlen = 1;
+			message.msg_control = control;
+			message.msg_controllen = sizeof(control);
+
+			const ssize_t received = recvmsg(this->m_socket, &message, flags);
+			if (received < 0) {
+				if (errno == EINTR) continue;
+				throw std::system_error(errno, std::generic_category(), "recvmsg");
+			}
+
+			for (cmsghdr* pControl = CMSG_FIRSTHDR(&message); pControl != nullptr; pControl = CMSG_NXTHDR(&message, pControl)) {
+
+				if ((pControl->cmsg_level != SOL_SOCKET) || (pControl->cmsg_type != SCM_RIGHTS)) continue;
+
+				int descriptor = -1;
+				std::memcpy(&descriptor, CMSG_DATA(pControl), sizeof(int));
+				QueryProtocol::SetCloseOnExec(descriptor);
+
+				if ((pDescriptor != nullptr) && (*pDescriptor < 0)) *pDescriptor = descriptor;
+				else close(descriptor);
+
+			}
+
+			if (received == 0) break;
+			total += static_cast<std::size_t>(received);
+
+		}
+
+		return total;
+	}
+
+	inline SharedMapping::SharedMapping(const int descriptor, const std::size_t size, const bool writable) : m_pData(nullptr), m_size(size) {
+
+		void* const pView = mmap(nullptr, size, (writable ? (PROT_READ | PROT_WRITE) : PROT_READ), MAP_SHARED, descriptor, 0);
+		if (pView == MAP_FAILED)
+			throw std::system_error(errno, std::generic_category(), "mmap");
+
+		this->m_pData = static_cast<char*>(pView);
+
+	}
+
+	inline SharedMapping::SharedMapping(SharedMapping&& other) noexcept
+		: m_pData(std::exchange(other.m_pData, nullptr)), m_size(std::exchange(other.m_size, 0)) { }
+
+	inline SharedMapping::~SharedMapping() {
+		if (this->m_pData != nullptr) munmap(this->m_pData, this->m_size);
+	}
+
+	inline auto SharedMapping::Data() const -> char* {
+		return this->m_pData;
+	}
+
+	inline auto SharedMapping::Size() const -> std::size_t {
+		return this->m_size;
+	}
+
+	inline QueryServer::QueryServer(const std::filesystem::path& socketPath, std::function<Database(void)> connect, const QueryServerOptions& options)
+		: m_path(socketPath), m_options(options), m_listener(-1), m_wakeup { -1, -1 }, m_stopping(false) {
+
+		if (!connect)
+			throw std::invalid_argument("'connect': Empty function.");
+
+		if (options.connections == 0)
+			throw std::invalid_argument("'options': Connection count cannot be zero.");
+
+		if ((options.batchSize == 0) || (options.batchSize > (options.ringSize / 2)))
+			throw std::invalid_argument("'options': Batch size must be positive and at most half of the ring size.");
+
+		const sockaddr_un address = QueryProtocol::MakeAddress(socketPath);
+
+		for (std::size_t i = 0; i < options.connections; ++i) {
+			this->m_connections.push_back(std::make_unique<Connection>(Connection { connect(), { }, { } }));
+			this->m_idle.push_back(this->m_connections.back().get());
+		}
+
+		if (pipe(this->m_wakeup) != 0)
+			throw std::system_error(errno, std::generic_category(), "pipe");
+
+		QueryProtocol::SetCloseOnExec(this->m_wakeup[0]);
+		QueryProtocol::SetCloseOnExec(this->m_wakeup[1]);
+
+		try {
+
+			this->m_listener = QueryProtocol::OpenSocket();
+
+			// A socket file left behind by a server that did not shut down cleanly would make bind()
+			// fail, so it is removed; any other kind of file is left alone.
+
+			std::error_code ec = { };
+			if (std::filesystem::is_socket(std::filesystem::symlink_status(socketPath, ec)))
+				std::filesystem::remove(socketPath, ec);
+
+			if (bind(this->m_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+				throw std::system_error(errno, std::generic_category(), "bind");
+
+			if (listen(this->m_listener, SOMAXCONN) != 0)
+				throw std::system_error(errno, std::generic_category(), "listen");
+
+		}
+		catch (...) {
+			if (this->m_listener >= 0) close(this->m_listener);
+			close(this->m_wakeup[0]);
+			close(this->m_wakeup[1]);
+			throw;
+		}
+
+		this->m_acceptor = std::jthread([this] { this->Accept(); });
+
+	}
+
+	inline QueryServer::~QueryServer() {
+		this->Stop();
+	}
+
+	inline auto QueryServer::Stop() -> void {
+
+		if (this->m_listener < 0) return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_poolMutex);
+			this->m_stopping = true;
+			for (const std::unique_ptr<Connection>& connection : this->m_connections)
+				sqlite3_interrupt(connection->db.ConnectionHandle());
+		}
+
+		this->m_poolSignal.notify_all();
+
+		const char signal = 0;
+		while ((write(this->m_wakeup[1], &signal, 1) < 0) && (errno == EINTR));
+
+		if (this->m_acceptor.joinable())
+			this->m_acceptor.join();
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_sessionsMutex);
+			for (Session& session : this->m_sessions)
+				session.channel.Shutdown();
+		}
+
+		for (Session& session : this->m_sessions)
+			if (session.thread.joinable()) session.thread.join();
+
+		this->m_sessions.clear();
+
+		close(this->m_listener);
+		close(this->m_wakeup[0]);
+		close(this->m_wakeup[1]);
+		this->m_listener = -1;
+
+		std::error_code ec = { };
+		std::filesystem::remove(this->m_path, ec);
+
+	}
+
+	inline auto QueryServer::Accept() -> void {
+
+		pollfd descriptors[2] = {
+			{ this->m_listener, POLLIN, 0 },
+			{ this->m_wakeup[0], POLLIN, 0 },
+		};
+
+		while (true) {
+
+			if (poll(descriptors, 2, -1) < 0) {
+				if (errno == EINTR) continue;
+				return;
+			}
+
+			if (descriptors[1].revents != 0) return;
+			if ((descriptors[0].revents & POLLIN) == 0) continue;
+
+			// When accept fails for lack of descriptors or memory, the listener stays readable. Back off
+			// for a moment instead of spinning on it; the wakeup pipe is still watched meanwhile.
+
+			const int socket = accept(this->m_listener, nullptr, nullptr);
+			if (socket < 0) {
+				if ((errno != EINTR) && (errno != ECONNABORTED) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+					poll(&descriptors[1], 1, 100);
+				continue;
+			}
+
+			QueryProtocol::SetCloseOnExec(socket);
+
+#ifdef SO_NOSIGPIPE
+			const int enable = 1;
+			setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+			std::lock_guard<std::mutex> lock(this->m_sessionsMutex);
+
+			for (auto it = this->m_sessions.begin(); it != this->m_sessions.end(); ) {
+				if (!it->finished.load(std::memory_order_acquire)) ++it;
+				else {
+					it->thread.join();
+					it = this->m_sessions.erase(it);
+				}
+			}
+
+			Session& session = this->m_sessions.emplace_back(socket);
+			session.thread = std::jthread([this, &session] { this->Serve(session); });
+
+		}
+
+	}
+
+	inline auto QueryServer::Serve(Session& session) -> void {
+
+		// A connection left inside a transaction stays pinned to the session until the transaction
+		// ends, so no other client ever sees it. Whatever is still open when the session ends is
+		// rolled back before the connection returns to the pool.
+
+		Connection* pPinned = nullptr;
+
+		try {
+
+			const int descriptor = QueryServer::CreateSharedMemory(this->m_options.ringSize);
+			std::optional<Ring> ring;
+
+			try {
+
+				ring.emplace(SharedMapping { descriptor, this->m_options.ringSize, true }, 0, 0);
+
+				std::string hello;
+				QueryProtocol::Append<std::uint64_t>(hello, this->m_options.ringSize);
+				session.channel.Send(QueryMessage::Hello, hello, descriptor);
+
+			}
+			catch (...) {
+				close(descriptor);
+				throw;
+			}
+
+			close(descriptor);
+
+			QueryMessage type = { };
+			std::string request;
+
+			while (session.channel.Receive(type, request, this->m_options.maxRequestSize)) {
+
+				if (type == QueryMessage::Consumed) {
+					ring->tail = QueryProtocol::Read<std::uint64_t>(request, 0);
+					continue;
+				}
+
+				if (type != QueryMessage::Query) break;
+
+				// Query: u32 SQL length, SQL text, then optionally the parameters encoded as one row
+				// (see RowCodec.hpp) starting at the next multiple of 8.
+
+				std::string error;
+				int code = SQLITE_OK;
+
+				const std::size_t length = ((request.size() >= 4) ? QueryProtocol::Read<std::uint32_t>(request, 0) : 0);
+				if ((request.size() < 4) || ((4 + length) > request.size())) {
+					std::string message;
+					QueryProtocol::Append<std::int32_t>(message, SQLITE_MISUSE);
+					message += "Malformed query message.";
+					session.channel.Send(QueryMessage::Error, message);
+					break;
+				}
+
+				const std::string_view sql = { (request.data() + 4), length };
+				const std::size_t offset = RowView::Align(4 + length);
+
+				Connection* const pConnection = ((pPinned != nullptr) ? pPinned : this->Acquire());
+				if (pConnection == nullptr) break;
+
+				pPinned = pConnection;
+
+				try {
+
+					std::optional<RowView> parameters;
+					if (offset < request.size())
+						parameters.emplace(std::span<const char>((request.data() + offset), (request.size() - offset)));
+
+					this->Run(*pConnection, session.channel, ring.value(), sql, parameters);
+
+				}
+				catch (const SqliteException& ex) {
+					code = ex.GetExtendedErrorCode();
+					error = ex.what();
+				}
+				catch (const std::invalid_argument& ex) {
+					code = SQLITE_MISUSE;
+					error = ex.what();
+				}
+
+				if (sqlite3_get_autocommit(pConnection->db.ConnectionHandle()) != 0) {
+					pPinned = nullptr;
+					this->Release(pConnection);
+				}
+
+				if (code != SQLITE_OK) {
+					std::string message;
+					QueryProtocol::Append<std::int32_t>(message, code);
+					message += error;
+					session.channel.Send(QueryMessage::Error, message);
+				}
+
+			}
+
+		}
+		catch (...) { }
+
+		if (pPinned != nullptr) {
+			sqlite3_exec(pPinned->db.ConnectionHandle(), "ROLLBACK;", nullptr, nullptr, nullptr);
+			this->Release(pPinned);
+		}
+
+		session.channel.Shutdown();
+
+		session.finished.store(true, std::memory_order_release);
+
+	}
+
+	inline auto QueryServer::Run(Connection& connection, QueryChannel& channel, Ring& ring, const std::string_view sql, const std::optional<RowView>& parameters) -> void {
+
+		Statement& stmt = this->Prepare(connection, sql);
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+
+		sqlite3_reset(pStmt);
+		sqlite3_clear_bindings(pStmt);
+
+		std::string batch;
+
+		try {
+
+			// Parameters are bound straight from the request buffer, which outlives the statement's
+			// execution; the bindings are cleared before returning.
+
+			if (parameters.has_value()) {
+
+				for (int i = 0; i < parameters->ColumnCount(); ++i) {
+
+					int res = SQLITE_OK;
+					const std::string_view bytes = parameters->Text(i);
+
+					switch (parameters->Type(i)) {
+					case SQLITE_INTEGER: res = sqlite3_bind_int64(pStmt, (i + 1), parameters->Integer(i)); break;
+					case SQLITE_FLOAT: res = sqlite3_bind_double(pStmt, (i + 1), parameters->Real(i)); break;
+					case SQLITE_TEXT: res = sqlite3_bind_text64(pStmt, (i + 1), bytes.data(), bytes.size(), SQLITE_STATIC, SQLITE_UTF8); break;
+					case SQLITE_BLOB: res = sqlite3_bind_blob64(pStmt, (i + 1), bytes.data(), bytes.size(), SQLITE_STATIC); break;
+					default: res = sqlite3_bind_null(pStmt, (i + 1)); break;
+					}
+
+					if (res != SQLITE_OK) throw SqliteException { pStmt };
+
+				}
+
+			}
+
+			stmt.Step();
+			while (sqlite3_data_count(pStmt) > 0) {
+
+				const std::size_t previous = batch.size();
+				EncodeRow(pStmt, batch);
+
+				if ((batch.size() > this->m_options.ringSize) && (previous > 0)) {
+					this->Publish(channel, ring, { batch.data(), previous });
+					batch.erase(0, previous);
+				}
+
+				if (batch.size() >= this->m_options.batchSize) {
+					this->Publish(channel, ring, batch);
+					batch.clear();
+				}
+
+				stmt.Step();
+			}
+
+			if (!batch.empty())
+				this->Publish(channel, ring, batch);
+
+		}
+		catch (...) {
+			sqlite3_reset(pStmt);
+			sqlite3_clear_bindings(pStmt);
+			throw;
+		}
+
+		sqlite3_reset(pStmt);
+		sqlite3_clear_bindings(pStmt);
+
+		std::string done;
+		QueryProtocol::Append<std::int64_t>(done, sqlite3_changes64(connection.db.ConnectionHandle()));
+		QueryProtocol::Append<std::int64_t>(done, sqlite3_last_insert_rowid(connection.db.ConnectionHandle()));
+
+		channel.Send(QueryMessage::Done, done);
+
+	}
+
+	inline auto QueryServer::Publish(QueryChannel& channel, Ring& ring, const std::string_view batch) -> void {
+
+		const std::uint64_t capacity = ring.mapping.Size();
+		const std::uint64_t size = batch.size();
+
+		if (size > capacity)
+			throw SqliteException { "Result row does not fit in the ring buffer.", SQLITE_TOOBIG };
+
+		// Batches are never split across the end of the ring, so the client can read rows in place.
+		// The skipped bytes count as used until the client consumes the batch after them.
+		//
+		// While the ring is full the statement stays open, holding its pooled connection and read
+		// transaction, until the client consumes a batch. A client that does not do so within
+		// 'consumeTimeout' is disconnected, which rolls back and releases the connection.
+
+		const std::uint64_t contiguous = (capacity - (ring.head % capacity));
+		const std::uint64_t start = ((size <= contiguous) ? ring.head : (ring.head + contiguous));
+
+		QueryMessage type = { };
+		std::string message;
+
+		while (true) {
+
+			if (ring.tail == ring.head) ring.tail = start;
+			if (((start + size) - ring.tail) <= capacity) break;
+
+			if ((this->m_options.consumeTimeout.count() > 0) && !channel.Wait(this->m_options.consumeTimeout))
+				throw std::system_error(std::make_error_code(std::errc::timed_out), "poll");
+
+			if (!channel.Receive(type, message, 64) || (type != QueryMessage::Consumed))
+				throw std::system_error(std::make_error_code(std::errc::connection_reset), "recv");
+
+			ring.tail = QueryProtocol::Read<std::uint64_t>(message, 0);
+
+		}
+
+		std::memcpy((ring.mapping.Data() + (start % capacity)), batch.data(), batch.size());
+		std::atomic_thread_fence(std::memory_order_release);
+
+		ring.head = (start + size);
+
+		message.clear();
+		QueryProtocol::Append<std::uint64_t>(message, start);
+		QueryProtocol::Append<std::uint64_t>(message, ring.head);
+
+		channel.Send(QueryMessage::Batch, message);
+
+	}
+
+	inline auto QueryServer::Acquire() -> Connection* {
+
+		std::unique_lock<std::mutex> lock(this->m_poolMutex);
+		this->m_poolSignal.wait(lock, [this] { return (this->m_stopping || !this->m_idle.empty()); });
+
+		if (this->m_stopping) return nullptr;
+
+		Connection* const pConnection = this->m_idle.back();
+		this->m_idle.pop_back();
+
+		return pConnection;
+	}
+
+	inline auto QueryServer::Release(Connection* const pConnection) -> void {
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_poolMutex);
+			this->m_idle.push_back(pConnection);
+		}
+
+		this->m_poolSignal.notify_one();
+
+	}
+
+	inline auto QueryServer::Prepare(Connection& connection, const std::string_view sql) -> Statement& {
+
+		std::string key = { sql.begin(), sql.end() };
+
+		auto it = connection.statements.find(key);
+		if (it != connection.statements.end()) {
+			connection.recent.splice(connection.recent.begin(), connection.recent, it->second.position);
+			return it->second.stmt;
+		}
+
+		Statement stmt = { connection.db, sql };
+
+		while (!connection.recent.empty() && (connection.statements.size() >= this->m_options.statementCacheSize)) {
+			connection.statements.erase(connection.recent.back());
+			connection.recent.pop_back();
+		}
+
+		connection.recent.push_front(key);
+		return connection.statements.emplace(std::move(key), CachedStatement { connection.recent.begin(), std::move(stmt) }).first->second.stmt;
+	}
+
+	inline auto QueryServer::CreateSharedMemory(const std::size_t size) -> int {
+
+		static std::atomic<std::uint64_t> counter = 0;
+
+		// The object is unlinked right away; it lives on through the descriptor passed to the client
+		// and both mappings.
+
+		for (int attempt = 0; attempt < 16; ++attempt) {
+
+			const std::string name = ("/vsqlite3-" + std::to_string(getpid()) + "-" + std::to_string(counter.fetch_add(1)));
+
+			const int descriptor = shm_open(name.c_str(), (O_RDWR | O_CREAT | O_EXCL), 0600);
+			if (descriptor < 0) {
+				if (errno == EEXIST) continue;
+				throw std::system_error(errno, std::generic_category(), "shm_open");
+			}
+
+			shm_unlink(name.c_str());
+			QueryProtocol::SetCloseOnExec(descriptor);
+
+			if (ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+				const int error = errno;
+				close(descriptor);
+				throw std::system_error(error, std::generic_category(), "ftruncate");
+			}
+
+			return descriptor;
+		}
+
+		throw std::system_error(std::make_error_code(std::errc::file_exists), "shm_open");
+	}
+
+	inline QueryClient::QueryClient(const std::filesystem::path& socketPath)
+		: m_pBatch(nullptr), m_batchSize(0), m_offset(0), m_batchEnd(0), m_unacknowledged(false), m_active(false), m_changes(0), m_lastInsertRowId(0) {
+
+		const sockaddr_un address = QueryProtocol::MakeAddress(socketPath);
+		const int socket = QueryProtocol::OpenSocket();
+
+		this->m_channel.emplace(socket);
+
+		if (connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+			throw std::system_error(errno, std::generic_category(), "connect");
+
+		QueryMessage type = { };
+		int descriptor = -1;
+
+		if (!this->m_channel->Receive(type, this->m_message, 64, &descriptor) || (type != QueryMessage::Hello) || (descriptor < 0)) {
+			if (descriptor >= 0) close(descriptor);
+			throw std::runtime_error("Query server did not send a ring buffer.");
+		}
+
+		try {
+
+			const std::uint64_t size = QueryProtocol::Read<std::uint64_t>(this->m_message, 0);
+
+			struct stat st = { };
+			if ((fstat(descriptor, &st) != 0) || (static_cast<std::uint64_t>(st.st_size) < size) || (size == 0))
+				throw std::runtime_error("Query server sent an invalid ring buffer.");
+
+			this->m_ring.emplace(descriptor, static_cast<std::size_t>(size), false);
+
+		}
+		catch (...) {
+			close(descriptor);
+			throw;
+		}
+
+		close(descriptor);
+
+	}
+
+	template <typename... Args>
+	inline auto QueryClient::Execute(const std::string_view sql, const Args&... args) -> void {
+
+		if (sql.empty())
+			throw std::invalid_argument("'sql': Empty string.");
+
+		this->Drain();
+
+		this->m_request.clear();
+		QueryProtocol::Append<std::uint32_t>(this->m_request, static_cast<std::uint32_t>(sql.size()));
+		this->m_request += sql;
+
+		if constexpr (sizeof...(Args) > 0) {
+			this->m_request.resize(RowView::Align(this->m_request.size()), '\0');
+			EncodeValues(this->m_request, args...);
+		}
+
+		this->m_channel->Send(QueryMessage::Query, this->m_request);
+		this->m_active = true;
+
+	}
+
+	inline auto QueryClient::Next(RowView& row) -> bool {
+
+		while (true) {
+
+			// Rows are read in place from the ring; a batch is handed back to the server only when
+			// the next call moves past it, so the last returned row stays valid until then.
+
+			if (this->m_offset < this->m_batchSize) {
+				row = RowView { std::span<const char>((this->m_pBatch + this->m_offset), (this->m_batchSize - this->m_offset)) };
+				this->m_offset += row.Size();
+				return true;
+			}
+
+			if (this->m_unacknowledged)
+				this->Acknowledge();
+
+			if (!this->m_active) return false;
+
+			QueryMessage type = { };
+			if (!this->m_channel->Receive(type, this->m_message, (1024 * 1024))) {
+				this->m_active = false;
+				throw std::system_error(std::make_error_code(std::errc::connection_reset), "recv");
+			}
+
+			if (type == QueryMessage::Batch) {
+
+				const std::uint64_t capacity = this->m_ring->Size();
+				const std::uint64_t start = QueryProtocol::Read<std::uint64_t>(this->m_message, 0);
+				const std::uint64_t end = QueryProtocol::Read<std::uint64_t>(this->m_message, 8);
+
+				if ((end <= start) || ((end - start) > (capacity - (start % capacity))))
+					throw std::runtime_error("Query server sent an invalid batch.");
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				this->m_pBatch = (this->m_ring->Data() + (start % capacity));
+				this->m_batchSize = static_cast<std::size_t>(end - start);
+				this->m_offset = 0;
+				this->m_batchEnd = end;
+				this->m_unacknowledged = true;
+
+			}
+			else if (type == QueryMessage::Done) {
+				this->m_changes = QueryProtocol::Read<std::int64_t>(this->m_message, 0);
+				this->m_lastInsertRowId = QueryProtocol::Read<std::int64_t>(this->m_message, 8);
+				this->m_active = false;
+			}
+			else if (type == QueryMessage::Error) {
+				this->m_active = false;
+				const int code = QueryProtocol::Read<std::int32_t>(this->m_message, 0);
+				throw SqliteException { this->m_message.substr(sizeof(std::int32_t)), code };
+			}
+			else {
+				this->m_active = false;
+				throw std::runtime_error("Unexpected message from the query server.");
+			}
+
+		}
+
+	}
+
+	template <typename... Args>
+	inline auto QueryClient::Fetch(Args&... args) -> bool {
+
+		RowView row;
+		if (!this->Next(row)) return false;
+
+		row.Column(args...);
+
+		return true;
+	}
+
+	inline auto QueryClient::Changes() -> sqlite3_int64 {
+		this->Drain();
+		return this->m_changes;
+	}
+
+	inline auto QueryClient::LastInsertRowId() -> sqlite3_int64 {
+		this->Drain();
+		return this->m_lastInsertRowId;
+	}
+
+	inline auto QueryClient::Acknowledge() -> void {
+
+		std::string message;
+		QueryProtocol::Append<std::uint64_t>(message, this->m_batchEnd);
+
+		this->m_pBatch = nullptr;
+		this->m_batchSize = 0;
+		this->m_offset = 0;
+		this->m_unacknowledged = false;
+
+		this->m_channel->Send(QueryMessage::Consumed, message);
+
+	}
+
+	inline auto QueryClient::Drain() -> void {
+		RowView row;
+		while (this->Next(row));
+	}
+
+}
+
+#endif // __VSQLITE3_QUERYSERVER_HPP__
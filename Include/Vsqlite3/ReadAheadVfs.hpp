@@ -0,0 +1,518 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_READAHEADVFS_HPP__
+#define __VSQLITE3_READAHEADVFS_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	struct ReadAheadOptions {
+		std::size_t sequentialThreshold = 4;
+		std::size_t minWindow = (64 * 1024);
+		std::size_t maxWindow = (4 * 1024 * 1024);
+	};
+
+	// Once a file is read sequentially, a background thread per file reads the following window
+	// through the wrapped file in 'ChunkSize' pieces so it lands in the OS page cache. The thread
+	// and SQLite share the wrapped file under a mutex, so a foreground read waits for at most one
+	// chunk. A second descriptor on the database file is not used: closing it would drop the
+	// process' POSIX advisory locks held by every other connection on the same file.
+
+	class ReadAheadVfs {
+
+	public:
+		ReadAheadVfs(const std::string_view name, const ReadAheadOptions& options = { }, const std::optional<std::string_view> baseVfs = std::nullopt, const bool makeDefault = false);
+		ReadAheadVfs(const ReadAheadVfs&) = delete;
+		ReadAheadVfs(ReadAheadVfs&&) = delete;
+		~ReadAheadVfs(void);
+
+		auto operator= (const ReadAheadVfs&) -> ReadAheadVfs& = delete;
+		auto operator= (ReadAheadVfs&&) -> ReadAheadVfs& = delete;
+
+		auto Name(void) const -> std::string_view;
+		auto Options(void) const -> const ReadAheadOptions&;
+
+	private:
+		static constexpr std::size_t ChunkSize = (128 * 1024);
+
+		struct Worker {
+			std::mutex io;
+			std::mutex mutex;
+			std::condition_variable signal;
+			sqlite3_int64 start = 0;
+			sqlite3_int64 end = 0;
+			bool stop = false;
+			std::unique_ptr<char[]> scratch;
+			std::thread thread;
+		};
+
+		struct File {
+			sqlite3_file base;
+			sqlite3_io_methods methods;
+			sqlite3_file* pReal;
+			const ReadAheadVfs* pVfs;
+			Worker* pWorker;
+			bool isMainDb;
+			sqlite3_int64 nextOffset;
+			sqlite3_int64 prefetchedUntil;
+			std::size_t run;
+			std::size_t window;
+		};
+
+		static auto Self(sqlite3_vfs* const pVfs) -> ReadAheadVfs*;
+		static auto Real(sqlite3_file* const pFile) -> sqlite3_file*;
+		static auto Exclusive(sqlite3_file* const pFile) -> std::unique_lock<std::mutex>;
+		static auto Advise(File* const pFile, const sqlite3_int64 offset, const int amount) -> void;
+		static auto Prefetch(File* const pFile, Worker* const pWorker) -> void;
+
+		static auto Open(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, int* pOutFlags) -> int;
+		static auto Delete(sqlite3_vfs* pVfs, const char* zName, int syncDir) -> int;
+		static auto Access(sqlite3_vfs* pVfs, const char* zName, int flags, int* pResOut) -> int;
+		static auto FullPathname(sqlite3_vfs* pVfs, const char* zName, int nOut, char* zOut) -> int;
+		static auto DlOpen(sqlite3_vfs* pVfs, const char* zFilename) -> void*;
+		static auto DlError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> void;
+		static auto DlSym(sqlite3_vfs* pVfs, void* pHandle, const char* zSymbol) -> void (*)(void);
+		static auto DlClose(sqlite3_vfs* pVfs, void* pHandle) -> void;
+		static auto Randomness(sqlite3_vfs* pVfs, int nByte, char* zOut) -> int;
+		static auto Sleep(sqlite3_vfs* pVfs, int microseconds) -> int;
+		static auto CurrentTime(sqlite3_vfs* pVfs, double* pTime) -> int;
+		static auto GetLastError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> int;
+		static auto CurrentTimeInt64(sqlite3_vfs* pVfs, sqlite3_int64* pTime) -> int;
+
+		static auto Close(sqlite3_file* pFile) -> int;
+		static auto Read(sqlite3_file* pFile, void* pBuf, int amount, sqlite3_int64 offset) -> int;
+		static auto Write(sqlite3_file* pFile, const void* pBuf, int amount, sqlite3_int64 offset) -> int;
+		static auto Truncate(sqlite3_file* pFile, sqlite3_int64 size) -> int;
+		static auto Sync(sqlite3_file* pFile, int flags) -> int;
+		static auto FileSize(sqlite3_file* pFile, sqlite3_int64* pSize) -> int;
+		static auto Lock(sqlite3_file* pFile, int lock) -> int;
+		static auto Unlock(sqlite3_file* pFile, int lock) -> int;
+		static auto CheckReservedLock(sqlite3_file* pFile, int* pResOut) -> int;
+		static auto FileControl(sqlite3_file* pFile, int op, void* pArg) -> int;
+		static auto SectorSize(sqlite3_file* pFile) -> int;
+		static auto DeviceCharacteristics(sqlite3_file* pFile) -> int;
+		static auto ShmMap(sqlite3_file* pFile, int region, int size, int extend, void volatile** pp) -> int;
+		static auto ShmLock(sqlite3_file* pFile, int offset, int n, int flags) -> int;
+		static auto ShmBarrier(sqlite3_file* pFile) -> void;
+		static auto ShmUnmap(sqlite3_file* pFile, int deleteFlag) -> int;
+		static auto Fetch(sqlite3_file* pFile, sqlite3_int64 offset, int amount, void** pp) -> int;
+		static auto Unfetch(sqlite3_file* pFile, sqlite3_int64 offset, void* p) -> int;
+
+		std::string m_name;
+		ReadAheadOptions m_options;
+		sqlite3_vfs* m_pBase;
+		sqlite3_vfs m_vfs;
+
+	};
+
+	inline ReadAheadVfs::ReadAheadVfs(const std::string_view name, const ReadAheadOptions& options, const std::optional<std::string_view> baseVfs, const bool makeDefault) {
+
+		if (name.empty())
+			throw std::invalid_argument("'name': Empty string.");
+
+		if ((options.minWindow == 0) || (options.minWindow > options.maxWindow))
+			throw std::invalid_argument("'options': Invalid read-ahead window.");
+
+		this->m_name = name;
+		this->m_options = options;
+
+		const std::optional<std::string> baseName { baseVfs };
+		this->m_pBase = sqlite3_vfs_find(baseName.has_value() ? baseName->c_str() : nullptr);
+		if (this->m_pBase == nullptr)
+			throw std::invalid_argument("'baseVfs': VFS does not exist.");
+
+		std::memset(&this->m_vfs, 0, sizeof(this->m_vfs));
+		this->m_vfs.iVersion = std::min(this->m_pBase->iVersion, 2);
+		this->m_vfs.szOsFile = static_cast<int>(sizeof(File) + this->m_pBase->szOsFile);
+		this->m_vfs.mxPathname = this->m_pBase->mxPathname;
+		this->m_vfs.zName = this->m_name.c_str();
+		this->m_vfs.pAppData = this;
+		this->m_vfs.xOpen = &ReadAheadVfs::Open;
+		this->m_vfs.xDelete = &ReadAheadVfs::Delete;
+		this->m_vfs.xAccess = &ReadAheadVfs::Access;
+		this->m_vfs.xFullPathname = &ReadAheadVfs::FullPathname;
+		this->m_vfs.xDlOpen = &ReadAheadVfs::DlOpen;
+		this->m_vfs.xDlError = &ReadAheadVfs::DlError;
+		this->m_vfs.xDlSym = &ReadAheadVfs::DlSym;
+		this->m_vfs.xDlClose = &ReadAheadVfs::DlClose;
+		this->m_vfs.xRandomness = &ReadAheadVfs::Randomness;
+		this->m_vfs.xSleep = &ReadAheadVfs::Sleep;
+		this->m_vfs.xCurrentTime = &ReadAheadVfs::CurrentTime;
+		this->m_vfs.xGetLastError = &ReadAheadVfs::GetLastError;
+		if (this->m_vfs.iVersion >= 2) this->m_vfs.xCurrentTimeInt64 = &ReadAheadVfs::CurrentTimeInt64;
+
+		const int res = sqlite3_vfs_register(&this->m_vfs, (makeDefault ? 1 : 0));
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline ReadAheadVfs::~ReadAheadVfs() {
+		sqlite3_vfs_unregister(&this->m_vfs);
+	}
+
+	inline auto ReadAheadVfs::Name() const -> std::string_view {
+		return this->m_name;
+	}
+
+	inline auto ReadAheadVfs::Options() const -> const ReadAheadOptions& {
+		return this->m_options;
+	}
+
+	inline auto ReadAheadVfs::Self(sqlite3_vfs* const pVfs) -> ReadAheadVfs* {
+		return static_cast<ReadAheadVfs*>(pVfs->pAppData);
+	}
+
+	inline auto ReadAheadVfs::Real(sqlite3_file* const pFile) -> sqlite3_file* {
+		return reinterpret_cast<File*>(pFile)->pReal;
+	}
+
+	inline auto ReadAheadVfs::Exclusive(sqlite3_file* const pFile) -> std::unique_lock<std::mutex> {
+		Worker* const pWorker = reinterpret_cast<File*>(pFile)->pWorker;
+		return ((pWorker != nullptr) ? std::unique_lock<std::mutex> { pWorker->io } : std::unique_lock<std::mutex> { });
+	}
+
+	inline auto ReadAheadVfs::Advise(File* const pFile, const sqlite3_int64 offset, const int amount) -> void {
+
+		if (!pFile->isMainDb) return;
+
+		const ReadAheadOptions& options = pFile->pVfs->m_options;
+
+		if (offset != pFile->nextOffset) {
+			pFile->run = 0;
+			pFile->window = options.minWindow;
+			pFile->prefetchedUntil = 0;
+		}
+		else ++pFile->run;
+
+		pFile->nextOffset = (offset + amount);
+
+		if (pFile->run < options.sequentialThreshold) return;
+		if ((pFile->prefetchedUntil - pFile->nextOffset) > static_cast<sqlite3_int64>(pFile->window / 2)) return;
+
+		const sqlite3_int64 start = std::max(pFile->nextOffset, pFile->prefetchedUntil);
+		const sqlite3_int64 end = (start + static_cast<sqlite3_int64>(pFile->window));
+
+		if (pFile->pWorker == nullptr) {
+
+			// Read-ahead is an optimization; if the thread cannot be started the file is read
+			// without it.
+
+			try {
+				auto worker = std::make_unique<Worker>();
+				worker->scratch = std::make_unique<char[]>(ChunkSize);
+				worker->thread = std::thread { &ReadAheadVfs::Prefetch, pFile, worker.get() };
+				pFile->pWorker = worker.release();
+			}
+			catch (...) {
+				return;
+			}
+
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock { pFile->pWorker->mutex };
+			if (pFile->pWorker->start >= pFile->pWorker->end) pFile->pWorker->start = start;
+			pFile->pWorker->end = end;
+		}
+
+		pFile->pWorker->signal.notify_one();
+
+		pFile->prefetchedUntil = end;
+		pFile->window = std::min((pFile->window * 2), options.maxWindow);
+
+	}
+
+	inline auto ReadAheadVfs::Prefetch(File* const pFile, Worker* const pWorker) -> void {
+
+		Worker& worker = *pWorker;
+
+		while (true) {
+
+			std::unique_lock<std::mutex> lock { worker.mutex };
+			worker.signal.wait(lock, [&worker] { return (worker.stop || (worker.start < worker.end)); });
+			if (worker.stop) return;
+
+			const sqlite3_int64 offset = worker.start;
+			const int amount = static_cast<int>(std::min(static_cast<sqlite3_int64>(ChunkSize), (worker.end - worker.start)));
+			worker.start += amount;
+			lock.unlock();
+
+			int res = SQLITE_OK;
+			{
+				const std::lock_guard<std::mutex> io { worker.io };
+				res = pFile->pReal->pMethods->xRead(pFile->pReal, worker.scratch.get(), amount, offset);
+			}
+
+			// A short read means the window ran past the end of the file; an error means the next
+			// foreground read will report it. Either way the rest of the window is dropped.
+
+			if (res != SQLITE_OK) {
+				lock.lock();
+				worker.start = worker.end;
+			}
+
+		}
+
+	}
+
+	inline auto ReadAheadVfs::Open(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, int* pOutFlags) -> int {
+
+		ReadAheadVfs* const pSelf = ReadAheadVfs::Self(pVfs);
+		File* const p = reinterpret_cast<File*>(pFile);
+
+		std::memset(p, 0, sizeof(File));
+		p->pReal = reinterpret_cast<sqlite3_file*>(p + 1);
+		p->pVfs = pSelf;
+		p->pWorker = nullptr;
+		p->isMainDb = ((flags & SQLITE_OPEN_MAIN_DB) != 0);
+		p->window = pSelf->m_options.minWindow;
+
+		const int res = pSelf->m_pBase->xOpen(pSelf->m_pBase, zName, p->pReal, flags, pOutFlags);
+		if (p->pReal->pMethods == nullptr) {
+			p->base.pMethods = nullptr;
+			return res;
+		}
+
+		const int version = p->pReal->pMethods->iVersion;
+		p->methods.iVersion = version;
+		p->methods.xClose = &ReadAheadVfs::Close;
+		p->methods.xRead = &ReadAheadVfs::Read;
+		p->methods.xWrite = &ReadAheadVfs::Write;
+		p->methods.xTruncate = &ReadAheadVfs::Truncate;
+		p->methods.xSync = &ReadAheadVfs::Sync;
+		p->methods.xFileSize = &ReadAheadVfs::FileSize;
+		p->methods.xLock = &ReadAheadVfs::Lock;
+		p->methods.xUnlock = &ReadAheadVfs::Unlock;
+		p->methods.xCheckReservedLock = &ReadAheadVfs::CheckReservedLock;
+		p->methods.xFileControl = &ReadAheadVfs::FileControl;
+		p->methods.xSectorSize = &ReadAheadVfs::SectorSize;
+		p->methods.xDeviceCharacteristics = &ReadAheadVfs::DeviceCharacteristics;
+		if (version >= 2) {
+			p->methods.xShmMap = &ReadAheadVfs::ShmMap;
+			p->methods.xShmLock = &ReadAheadVfs::ShmLock;
+			p->methods.xShmBarrier = &ReadAheadVfs::ShmBarrier;
+			p->methods.xShmUnmap = &ReadAheadVfs::ShmUnmap;
+		}
+		if (version >= 3) {
+			p->methods.xFetch = &ReadAheadVfs::Fetch;
+			p->methods.xUnfetch = &ReadAheadVfs::Unfetch;
+		}
+		p->base.pMethods = &p->methods;
+
+		return res;
+	}
+
+	inline auto ReadAheadVfs::Delete(sqlite3_vfs* pVfs, const char* zName, int syncDir) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xDelete(pBase, zName, syncDir);
+	}
+
+	inline auto ReadAheadVfs::Access(sqlite3_vfs* pVfs, const char* zName, int flags, int* pResOut) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xAccess(pBase, zName, flags, pResOut);
+	}
+
+	inline auto ReadAheadVfs::FullPathname(sqlite3_vfs* pVfs, const char* zName, int nOut, char* zOut) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xFullPathname(pBase, zName, nOut, zOut);
+	}
+
+	inline auto ReadAheadVfs::DlOpen(sqlite3_vfs* pVfs, const char* zFilename) -> void* {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xDlOpen(pBase, zFilename);
+	}
+
+	inline auto ReadAheadVfs::DlError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> void {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		pBase->xDlError(pBase, nByte, zErrMsg);
+	}
+
+	inline auto ReadAheadVfs::DlSym(sqlite3_vfs* pVfs, void* pHandle, const char* zSymbol) -> void (*)(void) {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xDlSym(pBase, pHandle, zSymbol);
+	}
+
+	inline auto ReadAheadVfs::DlClose(sqlite3_vfs* pVfs, void* pHandle) -> void {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		pBase->xDlClose(pBase, pHandle);
+	}
+
+	inline auto ReadAheadVfs::Randomness(sqlite3_vfs* pVfs, int nByte, char* zOut) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xRandomness(pBase, nByte, zOut);
+	}
+
+	inline auto ReadAheadVfs::Sleep(sqlite3_vfs* pVfs, int microseconds) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xSleep(pBase, microseconds);
+	}
+
+	inline auto ReadAheadVfs::CurrentTime(sqlite3_vfs* pVfs, double* pTime) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xCurrentTime(pBase, pTime);
+	}
+
+	inline auto ReadAheadVfs::GetLastError(sqlite3_vfs* pVfs, int nByte, char* zErrMsg) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return ((pBase->xGetLastError != nullptr) ? pBase->xGetLastError(pBase, nByte, zErrMsg) : 0);
+	}
+
+	inline auto ReadAheadVfs::CurrentTimeInt64(sqlite3_vfs* pVfs, sqlite3_int64* pTime) -> int {
+		sqlite3_vfs* const pBase = ReadAheadVfs::Self(pVfs)->m_pBase;
+		return pBase->xCurrentTimeInt64(pBase, pTime);
+	}
+
+	inline auto ReadAheadVfs::Close(sqlite3_file* pFile) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+
+		if (p->pWorker != nullptr) {
+
+			{
+				const std::lock_guard<std::mutex> lock { p->pWorker->mutex };
+				p->pWorker->stop = true;
+			}
+
+			p->pWorker->signal.notify_one();
+			p->pWorker->thread.join();
+
+			delete p->pWorker;
+			p->pWorker = nullptr;
+
+		}
+
+		return p->pReal->pMethods->xClose(p->pReal);
+	}
+
+	inline auto ReadAheadVfs::Read(sqlite3_file* pFile, void* pBuf, int amount, sqlite3_int64 offset) -> int {
+
+		File* const p = reinterpret_cast<File*>(pFile);
+
+		int res = SQLITE_OK;
+		{
+			const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+			res = p->pReal->pMethods->xRead(p->pReal, pBuf, amount, offset);
+		}
+
+		if (res == SQLITE_OK) ReadAheadVfs::Advise(p, offset, amount);
+
+		return res;
+	}
+
+	inline auto ReadAheadVfs::Write(sqlite3_file* pFile, const void* pBuf, int amount, sqlite3_int64 offset) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xWrite(pReal, pBuf, amount, offset);
+	}
+
+	inline auto ReadAheadVfs::Truncate(sqlite3_file* pFile, sqlite3_int64 size) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xTruncate(pReal, size);
+	}
+
+	inline auto ReadAheadVfs::Sync(sqlite3_file* pFile, int flags) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xSync(pReal, flags);
+	}
+
+	inline auto ReadAheadVfs::FileSize(sqlite3_file* pFile, sqlite3_int64* pSize) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xFileSize(pReal, pSize);
+	}
+
+	inline auto ReadAheadVfs::Lock(sqlite3_file* pFile, int lock) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xLock(pReal, lock);
+	}
+
+	inline auto ReadAheadVfs::Unlock(sqlite3_file* pFile, int lock) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xUnlock(pReal, lock);
+	}
+
+	inline auto ReadAheadVfs::CheckReservedLock(sqlite3_file* pFile, int* pResOut) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xCheckReservedLock(pReal, pResOut);
+	}
+
+	inline auto ReadAheadVfs::FileControl(sqlite3_file* pFile, int op, void* pArg) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xFileControl(pReal, op, pArg);
+	}
+
+	inline auto ReadAheadVfs::SectorSize(sqlite3_file* pFile) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xSectorSize(pReal);
+	}
+
+	inline auto ReadAheadVfs::DeviceCharacteristics(sqlite3_file* pFile) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xDeviceCharacteristics(pReal);
+	}
+
+	inline auto ReadAheadVfs::ShmMap(sqlite3_file* pFile, int region, int size, int extend, void volatile** pp) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xShmMap(pReal, region, size, extend, pp);
+	}
+
+	inline auto ReadAheadVfs::ShmLock(sqlite3_file* pFile, int offset, int n, int flags) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xShmLock(pReal, offset, n, flags);
+	}
+
+	inline auto ReadAheadVfs::ShmBarrier(sqlite3_file* pFile) -> void {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		pReal->pMethods->xShmBarrier(pReal);
+	}
+
+	inline auto ReadAheadVfs::ShmUnmap(sqlite3_file* pFile, int deleteFlag) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xShmUnmap(pReal, deleteFlag);
+	}
+
+	inline auto ReadAheadVfs::Fetch(sqlite3_file* pFile, sqlite3_int64 offset, int amount, void** pp) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xFetch(pReal, offset, amount, pp);
+	}
+
+	inline auto ReadAheadVfs::Unfetch(sqlite3_file* pFile, sqlite3_int64 offset, void* p) -> int {
+		const auto exclusive = ReadAheadVfs::Exclusive(pFile);
+		sqlite3_file* const pReal = ReadAheadVfs::Real(pFile);
+		return pReal->pMethods->xUnfetch(pReal, offset, p);
+	}
+
+}
+
+#endif // __VSQLITE3_READAHEADVFS_HPP__
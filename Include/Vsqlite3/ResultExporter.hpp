@@ -0,0 +1,450 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_RESULTEXPORTER_HPP__
+#define __VSQLITE3_RESULTEXPORTER_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/ByteScan.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <new>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace Vsqlite3 {
+
+	enum class ExportFormat : int {
+		Csv,
+		Tsv,
+		JsonLines,
+	};
+
+	struct ExportOptions {
+		ExportFormat format = ExportFormat::Csv;
+		bool header = true;
+		std::size_t bufferSize = (1024 * 1024);
+	};
+
+	using ExportSink = std::function<void(const std::span<const char>)>;
+
+	class ResultExporter {
+
+	public:
+		ResultExporter(ExportSink sink, const ExportOptions& options = { });
+		ResultExporter(const int fd, const ExportOptions& options = { });
+		ResultExporter(const ResultExporter&) = delete;
+		ResultExporter(ResultExporter&&) noexcept = default;
+		~ResultExporter(void);
+
+		auto operator= (const ResultExporter&) -> ResultExporter& = delete;
+		auto operator= (ResultExporter&&) noexcept -> ResultExporter& = default;
+
+		auto Export(Statement& stmt) -> std::uint64_t;
+		auto Flush(void) -> void;
+
+	private:
+		ExportSink m_sink;
+		ExportOptions m_options;
+		std::unique_ptr<char[]> m_buffer;
+		std::size_t m_used;
+		std::vector<std::string> m_keys;
+
+		auto Append(const char* pData, std::size_t size) -> void;
+		auto Append(const char ch) -> void;
+
+		auto WriteCsvRow(sqlite3_stmt* const pStmt, const int columns, const char delimiter) -> void;
+		auto WriteJsonRow(sqlite3_stmt* const pStmt, const int columns) -> void;
+
+		auto WriteNumber(sqlite3_stmt* const pStmt, const int column, const int type, const bool json) -> void;
+		auto WriteHex(const void* pData, const std::size_t size) -> void;
+		auto WriteCsvText(const std::string_view text, const char delimiter) -> void;
+		auto WriteJsonText(const std::string_view text) -> void;
+
+		template <typename Output>
+		static auto EscapeJson(const std::string_view text, Output&& output) -> void;
+
+	};
+
+	inline ResultExporter::ResultExporter(ExportSink sink, const ExportOptions& options)
+		: m_sink(std::move(sink)), m_options(options), m_used(0) {
+
+		if (!this->m_sink)
+			throw std::invalid_argument("'sink': Empty function.");
+
+		if (options.bufferSize < 64)
+			throw std::invalid_argument("'options': Buffer size must be at least 64 bytes.");
+
+		this->m_buffer = std::make_unique_for_overwrite<char[]>(options.bufferSize);
+
+	}
+
+	inline ResultExporter::ResultExporter(const int fd, const ExportOptions& options)
+		: ResultExporter([fd](const std::span<const char> data) {
+
+			const char* pData = data.data();
+			std::size_t remaining = data.size();
+
+			while (remaining > 0) {
+
+#if defined(_WIN32)
+				const int written = _write(fd, pData, static_cast<unsigned int>(std::min<std::size_t>(remaining, (1u << 30))));
+				if (written < 0) throw std::system_error(errno, std::generic_category(), "_write");
+#else
+				const ssize_t written = write(fd, pData, remaining);
+				if (written < 0) {
+					if (errno == EINTR) continue;
+					throw std::system_error(errno, std::generic_category(), "write");
+				}
+#endif
+
+				pData += written;
+				remaining -= static_cast<std::size_t>(written);
+
+			}
+
+		}, options) { }
+
+	inline ResultExporter::~ResultExporter() {
+
+		if (!this->m_buffer) return;
+
+		try { this->Flush(); }
+		catch (...) { }
+
+	}
+
+	inline auto ResultExporter::Export(Statement& stmt) -> std::uint64_t {
+
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+		const int columns = sqlite3_column_count(pStmt);
+
+		if (columns == 0)
+			throw std::invalid_argument("'stmt': Statement does not return data.");
+
+		const bool json = (this->m_options.format == ExportFormat::JsonLines);
+		const char delimiter = ((this->m_options.format == ExportFormat::Tsv) ? '\t' : ',');
+
+		if (json) {
+
+			this->m_keys.clear();
+			for (int i = 0; i < columns; ++i) {
+
+				const char* const pName = sqlite3_column_name(pStmt, i);
+				if (pName == nullptr) throw std::bad_alloc();
+
+				std::string& key = this->m_keys.emplace_back(((i == 0) ? "{\"" : ",\""));
+				ResultExporter::EscapeJson(pName, [&key](const char* pData, const std::size_t size) { key.append(pData, size); });
+				key += "\":";
+
+			}
+
+		}
+		else if (this->m_options.header) {
+
+			for (int i = 0; i < columns; ++i) {
+
+				const char* const pName = sqlite3_column_name(pStmt, i);
+				if (pName == nullptr) throw std::bad_alloc();
+
+				if (i != 0) this->Append(delimiter);
+				this->WriteCsvText(pName, delimiter);
+
+			}
+
+			this->Append('\n');
+
+		}
+
+		std::uint64_t rows = 0;
+
+		try {
+
+			stmt.Step();
+			while (sqlite3_data_count(pStmt) > 0) {
+
+				if (json) this->WriteJsonRow(pStmt, columns);
+				else this->WriteCsvRow(pStmt, columns, delimiter);
+
+				++rows;
+				stmt.Step();
+
+			}
+
+		}
+		catch (...) {
+			try { stmt.Reset(); }
+			catch (...) { }
+			throw;
+		}
+
+		stmt.Reset();
+		this->Flush();
+
+		return rows;
+	}
+
+	inline auto ResultExporter::Flush() -> void {
+
+		if (this->m_used == 0) return;
+
+		const std::size_t used = this->m_used;
+		this->m_used = 0;
+
+		this->m_sink({ this->m_buffer.get(), used });
+
+	}
+
+	inline auto ResultExporter::Append(const char* pData, std::size_t size) -> void {
+
+		const std::size_t capacity = this->m_options.bufferSize;
+
+		if ((capacity - this->m_used) < size) {
+
+			this->Flush();
+
+			if (size >= capacity) {
+				this->m_sink({ pData, size });
+				return;
+			}
+
+		}
+
+		std::memcpy((this->m_buffer.get() + this->m_used), pData, size);
+		this->m_used += size;
+
+	}
+
+	inline auto ResultExporter::Append(const char ch) -> void {
+
+		if (this->m_used == this->m_options.bufferSize)
+			this->Flush();
+
+		this->m_buffer[this->m_used++] = ch;
+
+	}
+
+	inline auto ResultExporter::WriteCsvRow(sqlite3_stmt* const pStmt, const int columns, const char delimiter) -> void {
+
+		for (int i = 0; i < columns; ++i) {
+
+			if (i != 0) this->Append(delimiter);
+
+			const int type = sqlite3_column_type(pStmt, i);
+			switch (type) {
+
+			case SQLITE_INTEGER:
+			case SQLITE_FLOAT:
+				this->WriteNumber(pStmt, i, type, false);
+				break;
+
+			case SQLITE_TEXT: {
+				const char* const pText = reinterpret_cast<const char*>(sqlite3_column_text(pStmt, i));
+				this->WriteCsvText({ pText, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)) }, delimiter);
+				break;
+			}
+
+			case SQLITE_BLOB: {
+				const void* const pBlob = sqlite3_column_blob(pStmt, i);
+				this->WriteHex(pBlob, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)));
+				break;
+			}
+
+			default:
+				break;
+
+			}
+
+		}
+
+		this->Append('\n');
+
+	}
+
+	inline auto ResultExporter::WriteJsonRow(sqlite3_stmt* const pStmt, const int columns) -> void {
+
+		for (int i = 0; i < columns; ++i) {
+
+			const std::string& key = this->m_keys[static_cast<std::size_t>(i)];
+			this->Append(key.data(), key.size());
+
+			const int type = sqlite3_column_type(pStmt, i);
+			switch (type) {
+
+			case SQLITE_INTEGER:
+			case SQLITE_FLOAT:
+				this->WriteNumber(pStmt, i, type, true);
+				break;
+
+			case SQLITE_TEXT: {
+				const char* const pText = reinterpret_cast<const char*>(sqlite3_column_text(pStmt, i));
+				this->WriteJsonText({ pText, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)) });
+				break;
+			}
+
+			case SQLITE_BLOB: {
+				const void* const pBlob = sqlite3_column_blob(pStmt, i);
+				this->Append('"');
+				this->WriteHex(pBlob, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)));
+				this->Append('"');
+				break;
+			}
+
+			default:
+				this->Append("null", 4);
+				break;
+
+			}
+
+		}
+
+		this->Append("}\n", 2);
+
+	}
+
+	inline auto ResultExporter::WriteNumber(sqlite3_stmt* const pStmt, const int column, const int type, const bool json) -> void {
+
+		char number[32] = { };
+		std::to_chars_result res = { };
+
+		if (type == SQLITE_INTEGER) res = std::to_chars(std::begin(number), std::end(number), sqlite3_column_int64(pStmt, column));
+		else {
+
+			const double value = sqlite3_column_double(pStmt, column);
+			if (json && !std::isfinite(value)) {
+				this->Append("null", 4);
+				return;
+			}
+
+			res = std::to_chars(std::begin(number), std::end(number), value);
+
+		}
+
+		this->Append(number, static_cast<std::size_t>(res.ptr - number));
+
+	}
+
+	inline auto ResultExporter::WriteHex(const void* pData, const std::size_t size) -> void {
+
+		constexpr char digits[] = "0123456789abcdef";
+		const std::uint8_t* const pBytes = static_cast<const std::uint8_t*>(pData);
+
+		char chunk[512];
+
+		for (std::size_t i = 0; i < size; ) {
+
+			const std::size_t count = std::min((size - i), (sizeof(chunk) / 2));
+			for (std::size_t j = 0; j < count; ++j, ++i) {
+				chunk[(j * 2)] = digits[pBytes[i] >> 4];
+				chunk[(j * 2) + 1] = digits[pBytes[i] & 0x0F];
+			}
+
+			this->Append(chunk, (count * 2));
+
+		}
+
+	}
+
+	inline auto ResultExporter::WriteCsvText(const std::string_view text, const char delimiter) -> void {
+
+		const char* p = text.data();
+		const char* const end = (p + text.size());
+
+		if (text.empty()) {
+			this->Append("\"\"", 2);
+			return;
+		}
+
+		const char* special = ByteScan::FindCsvSpecial(p, end, delimiter);
+		if (special == end) {
+			this->Append(p, text.size());
+			return;
+		}
+
+		this->Append('"');
+
+		while (true) {
+
+			const char* const quote = static_cast<const char*>(std::memchr(special, '"', static_cast<std::size_t>(end - special)));
+			if (quote == nullptr) break;
+
+			this->Append(p, static_cast<std::size_t>(quote - p + 1));
+			this->Append('"');
+
+			p = special = (quote + 1);
+
+		}
+
+		this->Append(p, static_cast<std::size_t>(end - p));
+		this->Append('"');
+
+	}
+
+	inline auto ResultExporter::WriteJsonText(const std::string_view text) -> void {
+
+		this->Append('"');
+		ResultExporter::EscapeJson(text, [this](const char* pData, const std::size_t size) { this->Append(pData, size); });
+		this->Append('"');
+
+	}
+
+	template <typename Output>
+	inline auto ResultExporter::EscapeJson(const std::string_view text, Output&& output) -> void {
+
+		constexpr char digits[] = "0123456789abcdef";
+
+		const char* p = text.data();
+		const char* const end = (p + text.size());
+
+		while (p < end) {
+
+			const char* const special = ByteScan::FindJsonSpecial(p, end);
+			output(p, static_cast<std::size_t>(special - p));
+			if (special == end) break;
+
+			const unsigned char ch = static_cast<unsigned char>(*special);
+			switch (ch) {
+			case '"': output("\\\"", 2); break;
+			case '\\': output("\\\\", 2); break;
+			case '\n': output("\\n", 2); break;
+			case '\r': output("\\r", 2); break;
+			case '\t': output("\\t", 2); break;
+			case '\b': output("\\b", 2); break;
+			case '\f': output("\\f", 2); break;
+			default: {
+				const char escape[6] = { '\\', 'u', '0', '0', digits[ch >> 4], digits[ch & 0x0F] };
+				output(escape, 6);
+				break;
+			}
+			}
+
+			p = (special + 1);
+
+		}
+
+	}
+
+}
+
+#endif // __VSQLITE3_RESULTEXPORTER_HPP__
@@ -0,0 +1,562 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_ROWCODEC_HPP__
+#define __VSQLITE3_ROWCODEC_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <span>
+#include <limits>
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	/*
+		Row layout (every part starts at a multiple of 8 bytes from the start of the row):
+
+			u32 size            Total size of the row, a multiple of 8.
+			u32 columns         Number of columns.
+			u8  type[columns]   SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, SQLITE_BLOB or SQLITE_NULL.
+			u64 slot[columns]   The value for INTEGER and FLOAT; for TEXT and BLOB, the u32 offset of
+			                    the bytes from the start of the row followed by their u32 length.
+			u8  payload[]       TEXT and BLOB bytes.
+
+		Values are stored in host byte order, so rows are meant for processes on the same machine.
+	*/
+
+	template <typename T>
+	struct IsRowEncodable : std::bool_constant<(std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::nullopt_t> || std::is_integral_v<T> || std::is_floating_point_v<T> ||
+		std::is_convertible_v<const T&, std::string_view> || std::is_convertible_v<const T&, std::span<const std::uint8_t>>)> { };
+
+	template <typename T>
+	struct IsRowEncodable<std::optional<T>> : IsRowEncodable<T> { };
+
+	template <typename T>
+	concept RowEncodable = IsRowEncodable<T>::value;
+
+	class RowWriter {
+
+	public:
+		RowWriter(std::string& out, const int columns);
+
+		auto Null(void) -> void;
+		auto Integer(const std::int64_t value) -> void;
+		auto Real(const double value) -> void;
+		auto Text(const std::string_view value) -> void;
+		auto Blob(const std::span<const std::uint8_t> value) -> void;
+
+		template <typename T>
+		auto Value(const T& value) -> void;
+
+		auto Finish(void) -> std::size_t;
+
+	private:
+		std::string* m_pOut;
+		std::size_t m_start;
+		std::uint32_t m_columns;
+		std::uint32_t m_column;
+
+		auto Next(const int type) -> char*;
+		auto Bytes(const int type, const void* const pBytes, const std::size_t length) -> void;
+
+		template <typename T>
+		struct IsOptional : std::false_type { };
+
+		template <typename T>
+		struct IsOptional<std::optional<T>> : std::true_type { };
+
+	};
+
+	inline auto EncodeRow(sqlite3_stmt* const pStmt, std::string& out) -> std::size_t;
+	inline auto EncodeRow(const Statement& stmt, std::string& out) -> std::size_t;
+
+	template <typename... Args>
+	inline auto EncodeValues(std::string& out, const Args&... values) -> std::size_t;
+
+	class RowView {
+
+	public:
+		RowView(void);
+		explicit RowView(const std::span<const char> data);
+
+		auto ColumnCount(void) const -> int;
+		auto Size(void) const -> std::size_t;
+
+		auto Type(const int column) const -> int;
+		auto Integer(const int column) const -> std::int64_t;
+		auto Real(const int column) const -> double;
+		auto Text(const int column) const -> std::string_view;
+		auto Blob(const int column) const -> std::span<const std::uint8_t>;
+
+		template <typename... Args>
+		auto Column(Args&... args) const -> void;
+
+		static constexpr auto Align(const std::size_t size) -> std::size_t {
+			return ((size + 7) & ~static_cast<std::size_t>(7));
+		}
+
+	private:
+		const char* m_pData;
+		std::uint32_t m_size;
+		std::uint32_t m_columns;
+
+		auto Slot(const int column) const -> const char*;
+		auto Bytes(const int column) const -> std::string_view;
+
+	};
+
+	class RowReader {
+
+	public:
+		explicit RowReader(const std::span<const char> data);
+
+		auto Next(RowView& row) -> bool;
+		auto Rewind(void) -> void;
+		auto Offset(void) const -> std::size_t;
+
+	private:
+		std::span<const char> m_data;
+		std::size_t m_offset;
+
+	};
+
+	template <typename T>
+	struct RowBinding;
+
+	template <typename T>
+	struct RowBinding<std::optional<T>> {
+
+		static inline auto Column(const RowView& row, const int column, std::optional<T>& arg) -> void {
+			if (row.Type(column) == SQLITE_NULL) arg = std::nullopt;
+			else RowBinding<T>::Column(row, column, arg.emplace());
+		}
+
+	};
+
+	template <std::integral T>
+	struct RowBinding<T> {
+
+		static inline auto Column(const RowView& row, const int column, T& arg) -> void {
+			arg = static_cast<T>(row.Integer(column));
+		}
+
+	};
+
+	template <std::floating_point T>
+	struct RowBinding<T> {
+
+		static inline auto Column(const RowView& row, const int column, T& arg) -> void {
+			arg = static_cast<T>(row.Real(column));
+		}
+
+	};
+
+	template <>
+	struct RowBinding<bool> {
+
+		static inline auto Column(const RowView& row, const int column, bool& arg) -> void {
+			arg = (row.Integer(column) != 0);
+		}
+
+	};
+
+	template <>
+	struct RowBinding<std::string_view> {
+
+		static inline auto Column(const RowView& row, const int column, std::string_view& arg) -> void {
+			arg = row.Text(column);
+		}
+
+	};
+
+	template <>
+	struct RowBinding<std::string> {
+
+		static inline auto Column(const RowView& row, const int column, std::string& arg) -> void {
+
+			char buffer[32] = { };
+
+			switch (row.Type(column)) {
+
+			case SQLITE_INTEGER:
+				arg.assign(buffer, std::to_chars(buffer, (buffer + sizeof(buffer)), row.Integer(column)).ptr);
+				break;
+
+			case SQLITE_FLOAT:
+				arg.assign(buffer, std::to_chars(buffer, (buffer + sizeof(buffer)), row.Real(column)).ptr);
+				if (arg.find_first_of(".eEn") == std::string::npos) arg += ".0";
+				break;
+
+			default:
+				arg = row.Text(column);
+				break;
+
+			}
+
+		}
+
+	};
+
+	template <>
+	struct RowBinding<std::span<const std::uint8_t>> {
+
+		static inline auto Column(const RowView& row, const int column, std::span<const std::uint8_t>& arg) -> void {
+			arg = row.Blob(column);
+		}
+
+	};
+
+	template <>
+	struct RowBinding<std::vector<std::uint8_t>> {
+
+		static inline auto Column(const RowView& row, const int column, std::vector<std::uint8_t>& arg) -> void {
+			const std::span<const std::uint8_t> blob = row.Blob(column);
+			arg.assign(blob.begin(), blob.end());
+		}
+
+	};
+
+	inline RowWriter::RowWriter(std::string& out, const int columns) : m_pOut(&out), m_start(out.size()), m_column(0) {
+
+		if (columns <= 0)
+			throw std::invalid_argument("'columns': Column count must be positive.");
+
+		this->m_columns = static_cast<std::uint32_t>(columns);
+
+		out.resize((this->m_start + 8 + RowView::Align(this->m_columns) + (static_cast<std::size_t>(this->m_columns) * 8)), '\0');
+		std::memset((out.data() + this->m_start + 8), SQLITE_NULL, this->m_columns);
+
+	}
+
+	inline auto RowWriter::Null() -> void {
+		this->Next(SQLITE_NULL);
+	}
+
+	inline auto RowWriter::Integer(const std::int64_t value) -> void {
+		std::memcpy(this->Next(SQLITE_INTEGER), &value, sizeof(value));
+	}
+
+	inline auto RowWriter::Real(const double value) -> void {
+		std::memcpy(this->Next(SQLITE_FLOAT), &value, sizeof(value));
+	}
+
+	inline auto RowWriter::Text(const std::string_view value) -> void {
+		this->Bytes(SQLITE_TEXT, value.data(), value.size());
+	}
+
+	inline auto RowWriter::Blob(const std::span<const std::uint8_t> value) -> void {
+		this->Bytes(SQLITE_BLOB, value.data(), value.size());
+	}
+
+	template <typename T>
+	inline auto RowWriter::Value(const T& value) -> void {
+
+		if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::nullopt_t>) this->Null();
+		else if constexpr (IsOptional<T>::value) {
+			if (value.has_value()) this->Value(value.value());
+			else this->Null();
+		}
+		else if constexpr (std::is_integral_v<T>) this->Integer(static_cast<std::int64_t>(value));
+		else if constexpr (std::is_floating_point_v<T>) this->Real(static_cast<double>(value));
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>) this->Text(value);
+		else if constexpr (std::is_convertible_v<const T&, std::span<const std::uint8_t>>) this->Blob(value);
+		else static_assert(!sizeof(T), "Type cannot be encoded as a row value.");
+
+	}
+
+	inline auto RowWriter::Finish() -> std::size_t {
+
+		std::string& out = *this->m_pOut;
+		out.resize((this->m_start + RowView::Align(out.size() - this->m_start)), '\0');
+
+		const std::size_t size = (out.size() - this->m_start);
+		if (size > std::numeric_limits<std::uint32_t>::max()) {
+			out.resize(this->m_start);
+			throw std::length_error("Encoded row exceeds 4 GiB.");
+		}
+
+		const std::uint32_t header[2] = { static_cast<std::uint32_t>(size), this->m_columns };
+		std::memcpy((out.data() + this->m_start), header, sizeof(header));
+
+		return size;
+	}
+
+	inline auto RowWriter::Next(const int type) -> char* {
+
+		if (this->m_column >= this->m_columns)
+			throw std::out_of_range("Row has no more columns.");
+
+		const std::size_t column = this->m_column++;
+		char* const pRow = (this->m_pOut->data() + this->m_start);
+
+		pRow[8 + column] = static_cast<char>(type);
+
+		return (pRow + 8 + RowView::Align(this->m_columns) + (column * 8));
+	}
+
+	inline auto RowWriter::Bytes(const int type, const void* const pBytes, const std::size_t length) -> void {
+
+		std::string& out = *this->m_pOut;
+		const std::size_t offset = (out.size() - this->m_start);
+
+		if ((offset + length) > std::numeric_limits<std::uint32_t>::max()) {
+			out.resize(this->m_start);
+			throw std::length_error("Encoded row exceeds 4 GiB.");
+		}
+
+		const std::uint32_t location[2] = { static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(length) };
+		std::memcpy(this->Next(type), location, sizeof(location));
+
+		if (length > 0) out.append(static_cast<const char*>(pBytes), length);
+
+	}
+
+	inline auto EncodeRow(sqlite3_stmt* const pStmt, std::string& out) -> std::size_t {
+
+		const int columns = sqlite3_data_count(pStmt);
+		if (columns <= 0)
+			throw std::invalid_argument("'pStmt': Statement has no current row.");
+
+		RowWriter writer = { out, columns };
+
+		for (int i = 0; i < columns; ++i) {
+
+			switch (sqlite3_column_type(pStmt, i)) {
+
+			case SQLITE_INTEGER:
+				writer.Integer(sqlite3_column_int64(pStmt, i));
+				break;
+
+			case SQLITE_FLOAT:
+				writer.Real(sqlite3_column_double(pStmt, i));
+				break;
+
+			case SQLITE_TEXT: {
+				const char* const pText = reinterpret_cast<const char*>(sqlite3_column_text(pStmt, i));
+				writer.Text({ pText, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)) });
+				break;
+			}
+
+			case SQLITE_BLOB: {
+				const std::uint8_t* const pBlob = static_cast<const std::uint8_t*>(sqlite3_column_blob(pStmt, i));
+				writer.Blob({ pBlob, static_cast<std::size_t>(sqlite3_column_bytes(pStmt, i)) });
+				break;
+			}
+
+			default:
+				writer.Null();
+				break;
+
+			}
+
+		}
+
+		return writer.Finish();
+	}
+
+	inline auto EncodeRow(const Statement& stmt, std::string& out) -> std::size_t {
+		return EncodeRow(stmt.StatementHandle(), out);
+	}
+
+	template <typename... Args>
+	inline auto EncodeValues(std::string& out, const Args&... values) -> std::size_t {
+
+		static_assert((sizeof...(Args) > 0), "At least one value must be specified.");
+
+		RowWriter writer = { out, static_cast<int>(sizeof...(Args)) };
+		(writer.Value(values), ...);
+
+		return writer.Finish();
+	}
+
+	inline RowView::RowView() : m_pData(nullptr), m_size(0), m_columns(0) { }
+
+	inline RowView::RowView(const std::span<const char> data) : RowView() {
+
+		// Rows may come from another process, so the header and every TEXT and BLOB location are
+		// checked once here and the accessors can stay unchecked.
+
+		std::uint32_t header[2] = { };
+		if (data.size() < sizeof(header))
+			throw std::invalid_argument("'data': Truncated row.");
+
+		std::memcpy(header, data.data(), sizeof(header));
+
+		const std::size_t size = header[0];
+		const std::size_t columns = header[1];
+		const std::size_t payload = (8 + RowView::Align(columns) + (columns * 8));
+
+		if ((size > data.size()) || ((size % 8) != 0) || (payload > size))
+			throw std::invalid_argument("'data': Malformed row header.");
+
+		for (std::size_t i = 0; i < columns; ++i) {
+
+			const int type = static_cast<unsigned char>(data[8 + i]);
+			if ((type < SQLITE_INTEGER) || (type > SQLITE_NULL))
+				throw std::invalid_argument("'data': Unknown column type.");
+
+			if ((type == SQLITE_TEXT) || (type == SQLITE_BLOB)) {
+
+				std::uint32_t location[2] = { };
+				std::memcpy(location, (data.data() + 8 + RowView::Align(columns) + (i * 8)), sizeof(location));
+
+				if ((location[0] < payload) || ((static_cast<std::size_t>(location[0]) + location[1]) > size))
+					throw std::invalid_argument("'data': Column bytes out of bounds.");
+
+			}
+
+		}
+
+		this->m_pData = data.data();
+		this->m_size = header[0];
+		this->m_columns = header[1];
+
+	}
+
+	inline auto RowView::ColumnCount() const -> int {
+		return static_cast<int>(this->m_columns);
+	}
+
+	inline auto RowView::Size() const -> std::size_t {
+		return this->m_size;
+	}
+
+	inline auto RowView::Type(const int column) const -> int {
+		if ((column < 0) || (static_cast<std::uint32_t>(column) >= this->m_columns)) return SQLITE_NULL;
+		return static_cast<unsigned char>(this->m_pData[8 + column]);
+	}
+
+	inline auto RowView::Integer(const int column) const -> std::int64_t {
+
+		std::int64_t value = 0;
+
+		switch (this->Type(column)) {
+
+		case SQLITE_INTEGER:
+			std::memcpy(&value, this->Slot(column), sizeof(value));
+			break;
+
+		case SQLITE_FLOAT: {
+
+			// Clamped the way sqlite3_column_int64() converts: out-of-range values saturate and NaN
+			// becomes 0, rather than being cast (which is undefined).
+
+			const double real = this->Real(column);
+			constexpr double min = static_cast<double>(std::numeric_limits<std::int64_t>::min());
+			constexpr double max = static_cast<double>(std::numeric_limits<std::int64_t>::max());
+
+			if (std::isnan(real)) value = 0;
+			else if (real <= min) value = std::numeric_limits<std::int64_t>::min();
+			else if (real >= max) value = std::numeric_limits<std::int64_t>::max();
+			else value = static_cast<std::int64_t>(real);
+
+			break;
+		}
+
+		case SQLITE_TEXT: {
+			const std::string_view text = this->Bytes(column);
+			const std::size_t first = std::min(text.find_first_not_of(" \t\n\r"), text.size());
+			std::from_chars((text.data() + first), (text.data() + text.size()), value);
+			break;
+		}
+
+		}
+
+		return value;
+	}
+
+	inline auto RowView::Real(const int column) const -> double {
+
+		double value = 0.0;
+
+		switch (this->Type(column)) {
+
+		case SQLITE_INTEGER:
+			value = static_cast<double>(this->Integer(column));
+			break;
+
+		case SQLITE_FLOAT:
+			std::memcpy(&value, this->Slot(column), sizeof(value));
+			break;
+
+		case SQLITE_TEXT: {
+			const std::string_view text = this->Bytes(column);
+			const std::size_t first = std::min(text.find_first_not_of(" \t\n\r"), text.size());
+			std::from_chars((text.data() + first), (text.data() + text.size()), value);
+			break;
+		}
+
+		}
+
+		return value;
+	}
+
+	inline auto RowView::Text(const int column) const -> std::string_view {
+		return this->Bytes(column);
+	}
+
+	inline auto RowView::Blob(const int column) const -> std::span<const std::uint8_t> {
+		const std::string_view bytes = this->Bytes(column);
+		return { reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size() };
+	}
+
+	template <typename... Args>
+	inline auto RowView::Column(Args&... args) const -> void {
+		int column = 0;
+		(RowBinding<Args>::Column(*this, column++, args), ...);
+	}
+
+	inline auto RowView::Slot(const int column) const -> const char* {
+		return (this->m_pData + 8 + RowView::Align(this->m_columns) + (static_cast<std::size_t>(column) * 8));
+	}
+
+	inline auto RowView::Bytes(const int column) const -> std::string_view {
+
+		const int type = this->Type(column);
+		if ((type != SQLITE_TEXT) && (type != SQLITE_BLOB)) return { };
+
+		std::uint32_t location[2] = { };
+		std::memcpy(location, this->Slot(column), sizeof(location));
+
+		return { (this->m_pData + location[0]), location[1] };
+	}
+
+	inline RowReader::RowReader(const std::span<const char> data) : m_data(data), m_offset(0) { }
+
+	inline auto RowReader::Next(RowView& row) -> bool {
+
+		if (this->m_offset >= this->m_data.size()) return false;
+
+		row = RowView { this->m_data.subspan(this->m_offset) };
+		this->m_offset += row.Size();
+
+		return true;
+	}
+
+	inline auto RowReader::Rewind() -> void {
+		this->m_offset = 0;
+	}
+
+	inline auto RowReader::Offset() const -> std::size_t {
+		return this->m_offset;
+	}
+
+}
+
+#endif // __VSQLITE3_ROWCODEC_HPP__
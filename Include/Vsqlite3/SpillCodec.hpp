@@ -0,0 +1,94 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_SPILLCODEC_HPP__
+#define __VSQLITE3_SPILLCODEC_HPP__
+
+#include <string>
+#include <optional>
+#include <vector>
+#include <type_traits>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+
+namespace Vsqlite3 {
+
+	template <typename T>
+	struct SpillCodec;
+
+	template <typename T>
+	concept Spillable = requires (std::string& out, const char*& in, const T& value, T& result) {
+		SpillCodec<T>::Encode(out, value);
+		SpillCodec<T>::Decode(in, result);
+	};
+
+	template <typename T> requires std::is_arithmetic_v<T>
+	struct SpillCodec<T> {
+
+		static inline auto Encode(std::string& out, const T& value) -> void {
+			out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		static inline auto Decode(const char*& in, T& value) -> void {
+			std::memcpy(&value, in, sizeof(T));
+			in += sizeof(T);
+		}
+
+	};
+
+	template <>
+	struct SpillCodec<std::string> {
+
+		static inline auto Encode(std::string& out, const std::string& value) -> void {
+			SpillCodec<std::uint64_t>::Encode(out, value.size());
+			out.append(value);
+		}
+
+		static inline auto Decode(const char*& in, std::string& value) -> void {
+			std::uint64_t size = 0;
+			SpillCodec<std::uint64_t>::Decode(in, size);
+			value.assign(in, static_cast<std::size_t>(size));
+			in += size;
+		}
+
+	};
+
+	template <>
+	struct SpillCodec<std::vector<std::uint8_t>> {
+
+		static inline auto Encode(std::string& out, const std::vector<std::uint8_t>& value) -> void {
+			SpillCodec<std::uint64_t>::Encode(out, value.size());
+			out.append(reinterpret_cast<const char*>(value.data()), value.size());
+		}
+
+		static inline auto Decode(const char*& in, std::vector<std::uint8_t>& value) -> void {
+			std::uint64_t size = 0;
+			SpillCodec<std::uint64_t>::Decode(in, size);
+			value.assign(reinterpret_cast<const std::uint8_t*>(in), reinterpret_cast<const std::uint8_t*>(in + size));
+			in += size;
+		}
+
+	};
+
+	template <Spillable T>
+	struct SpillCodec<std::optional<T>> {
+
+		static inline auto Encode(std::string& out, const std::optional<T>& value) -> void {
+			out.push_back(static_cast<char>(value.has_value()));
+			if (value.has_value()) SpillCodec<T>::Encode(out, value.value());
+		}
+
+		static inline auto Decode(const char*& in, std::optional<T>& value) -> void {
+			if (*in++ == 0) value.reset();
+			else SpillCodec<T>::Decode(in, value.emplace());
+		}
+
+	};
+
+}
+
+#endif // __VSQLITE3_SPILLCODEC_HPP__
@@ -0,0 +1,69 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_STRINGARENA_HPP__
+#define __VSQLITE3_STRINGARENA_HPP__
+
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace Vsqlite3 {
+
+	class StringArena {
+
+	public:
+		StringArena(const std::size_t chunkSize = (64 * 1024));
+		StringArena(const StringArena&) = delete;
+		StringArena(StringArena&&) noexcept = default;
+
+		auto operator= (const StringArena&) -> StringArena& = delete;
+		auto operator= (StringArena&&) noexcept -> StringArena& = default;
+
+		auto Store(const std::string_view str) -> std::string_view;
+		auto Size(void) const -> std::size_t;
+
+	private:
+		std::size_t m_chunkSize;
+		std::vector<std::unique_ptr<char[]>> m_chunks;
+		std::size_t m_used;
+		std::size_t m_capacity;
+		std::size_t m_size;
+
+	};
+
+	inline StringArena::StringArena(const std::size_t chunkSize)
+		: m_chunkSize(std::max<std::size_t>(chunkSize, 1)), m_used(0), m_capacity(0), m_size(0) { }
+
+	inline auto StringArena::Store(const std::string_view str) -> std::string_view {
+
+		if (str.empty()) return { };
+
+		if ((this->m_capacity - this->m_used) < str.size()) {
+			this->m_capacity = std::max(this->m_chunkSize, str.size());
+			this->m_chunks.push_back(std::make_unique_for_overwrite<char[]>(this->m_capacity));
+			this->m_used = 0;
+		}
+
+		char* const pStr = (this->m_chunks.back().get() + this->m_used);
+		std::memcpy(pStr, str.data(), str.size());
+
+		this->m_used += str.size();
+		this->m_size += str.size();
+
+		return { pStr, str.size() };
+	}
+
+	inline auto StringArena::Size() const -> std::size_t {
+		return this->m_size;
+	}
+
+}
+
+#endif // __VSQLITE3_STRINGARENA_HPP__
@@ -0,0 +1,288 @@
+/*
+	Vsqlite3
+	Copyright (c) 2025 V0idPointer
+	Licensed under the MIT License
+*/
+
+#ifndef __VSQLITE3_TABLESNAPSHOT_HPP__
+#define __VSQLITE3_TABLESNAPSHOT_HPP__
+
+#include <Vsqlite3/Vsqlite3.hpp>
+#include <Vsqlite3/StringArena.hpp>
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <span>
+#include <tuple>
+#include <numeric>
+#include <limits>
+#include <algorithm>
+#include <bit>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <chrono>
+#include <functional>
+#include <exception>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace Vsqlite3 {
+
+	template <typename Key, typename Row>
+	class TableSnapshot;
+
+	template <typename Key, typename... Columns>
+	class TableSnapshot<Key, std::tuple<Columns...>> {
+
+	public:
+		using Row = std::tuple<Columns...>;
+
+		class View {
+
+		public:
+			View(const Database& db, const std::string_view sql);
+			View(const View&) = delete;
+
+			auto operator= (const View&) -> View& = delete;
+
+			auto Find(const Key& key) const -> const Row*;
+			auto Range(const Key& lo, const Key& hi) const -> std::span<const Row>;
+
+			auto Keys(void) const -> std::span<const Key>;
+			auto Rows(void) const -> std::span<const Row>;
+			auto Size(void) const -> std::size_t;
+
+		private:
+			StringArena m_strings;
+			std::vector<Key> m_keys;
+			std::vector<Row> m_rows;
+			std::vector<Key> m_eytzingerKeys;
+			std::vector<std::uint32_t> m_eytzingerIndices;
+
+			template <typename T>
+			auto Read(sqlite3_stmt* const pStmt, const int column, T& value) -> void;
+
+			auto BuildEytzinger(const std::size_t node, std::size_t& next) -> void;
+
+		};
+
+		TableSnapshot(const Database& db, const std::string_view sql);
+		TableSnapshot(const TableSnapshot&) = delete;
+		~TableSnapshot(void);
+
+		auto operator= (const TableSnapshot&) -> TableSnapshot& = delete;
+
+		auto Acquire(void) const -> std::shared_ptr<const View>;
+		auto Reload(const Database& db) -> void;
+
+		auto StartRefresh(std::function<Database(void)> connect, const std::chrono::milliseconds interval, std::function<void(std::exception_ptr)> onError = nullptr) -> void;
+		auto StopRefresh(void) -> void;
+
+	private:
+		std::string m_sql;
+		std::atomic<std::shared_ptr<const View>> m_view;
+
+		std::mutex m_refreshMutex;
+		std::condition_variable_any m_refreshSignal;
+		std::jthread m_refresher;
+
+	};
+
+	template <typename Key, typename... Columns>
+	inline TableSnapshot<Key, std::tuple<Columns...>>::View::View(const Database& db, const std::string_view sql) {
+
+		Statement stmt = { db, sql };
+		sqlite3_stmt* const pStmt = stmt.StatementHandle();
+
+		if (sqlite3_column_count(pStmt) != static_cast<int>(sizeof...(Columns) + 1))
+			throw std::invalid_argument("'sql': Column count does not match the key and row types.");
+
+		std::vector<Key> keys;
+		std::vector<Row> rows;
+
+		stmt.Step();
+		while (sqlite3_data_count(pStmt) > 0) {
+
+			Key& key = keys.emplace_back();
+			this->Read(pStmt, 0, key);
+
+			Row& row = rows.emplace_back();
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				(this->Read(pStmt, static_cast<int>(I + 1), std::get<I>(row)), ...);
+			}(std::index_sequence_for<Columns...> { });
+
+			stmt.Step();
+
+		}
+
+		if (keys.size() > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("Snapshot has too many rows.");
+
+		std::vector<std::uint32_t> order(keys.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&keys](const std::uint32_t lhs, const std::uint32_t rhs) {
+			return (keys[lhs] < keys[rhs]);
+		});
+
+		this->m_keys.reserve(keys.size());
+		this->m_rows.reserve(rows.size());
+		for (const std::uint32_t i : order) {
+			this->m_keys.push_back(std::move(keys[i]));
+			this->m_rows.push_back(std::move(rows[i]));
+		}
+
+		this->m_eytzingerKeys.resize(this->m_keys.size() + 1);
+		this->m_eytzingerIndices.resize(this->m_keys.size() + 1);
+
+		std::size_t next = 0;
+		this->BuildEytzinger(1, next);
+
+	}
+
+	template <typename Key, typename... Columns>
+	template <typename T>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Read(sqlite3_stmt* const pStmt, const int column, T& value) -> void {
+
+		if constexpr (std::is_same_v<T, std::string_view>) {
+			const unsigned char* pText = sqlite3_column_text(pStmt, column);
+			const int len = sqlite3_column_bytes(pStmt, column);
+			value = this->m_strings.Store({ reinterpret_cast<const char*>(pText), static_cast<std::size_t>(len) });
+		}
+		else Binding<T>::Column(pStmt, column, value);
+
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::BuildEytzinger(const std::size_t node, std::size_t& next) -> void {
+
+		if (node > this->m_keys.size()) return;
+
+		this->BuildEytzinger((2 * node), next);
+		this->m_eytzingerKeys[node] = this->m_keys[next];
+		this->m_eytzingerIndices[node] = static_cast<std::uint32_t>(next++);
+		this->BuildEytzinger((2 * node + 1), next);
+
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Find(const Key& key) const -> const Row* {
+
+		const std::size_t size = this->m_keys.size();
+		std::size_t node = 1;
+
+		while (node <= size)
+			node = ((2 * node) + static_cast<std::size_t>(this->m_eytzingerKeys[node] < key));
+
+		node >>= (std::countr_one(node) + 1);
+		if ((node == 0) || (key < this->m_eytzingerKeys[node])) return nullptr;
+
+		return &this->m_rows[this->m_eytzingerIndices[node]];
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Range(const Key& lo, const Key& hi) const -> std::span<const Row> {
+
+		const auto first = std::lower_bound(this->m_keys.begin(), this->m_keys.end(), lo);
+		const auto last = std::lower_bound(first, this->m_keys.end(), hi);
+
+		const std::size_t offset = static_cast<std::size_t>(first - this->m_keys.begin());
+		const std::size_t count = static_cast<std::size_t>(last - first);
+
+		return std::span<const Row> { this->m_rows }.subspan(offset, count);
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Keys() const -> std::span<const Key> {
+		return this->m_keys;
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Rows() const -> std::span<const Row> {
+		return this->m_rows;
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::View::Size() const -> std::size_t {
+		return this->m_keys.size();
+	}
+
+	template <typename Key, typename... Columns>
+	inline TableSnapshot<Key, std::tuple<Columns...>>::TableSnapshot(const Database& db, const std::string_view sql) : m_sql(sql) {
+		this->Reload(db);
+	}
+
+	template <typename Key, typename... Columns>
+	inline TableSnapshot<Key, std::tuple<Columns...>>::~TableSnapshot() {
+		this->StopRefresh();
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::Acquire() const -> std::shared_ptr<const View> {
+		return this->m_view.load(std::memory_order_acquire);
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::Reload(const Database& db) -> void {
+		this->m_view.store(std::make_shared<const View>(db, this->m_sql), std::memory_order_release);
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::StartRefresh(std::function<Database(void)> connect, const std::chrono::milliseconds interval, std::function<void(std::exception_ptr)> onError) -> void {
+
+		if (!connect)
+			throw std::invalid_argument("'connect': Empty function.");
+
+		this->StopRefresh();
+
+		this->m_refresher = std::jthread([this, connect = std::move(connect), interval, onError = std::move(onError)](const std::stop_token token) {
+
+			std::optional<Database> db;
+			std::optional<DataVersionWatcher> watcher;
+
+			while (!token.stop_requested()) {
+
+				try {
+
+					if (!db.has_value()) {
+						db.emplace(connect());
+						watcher.emplace(db.value());
+						this->Reload(db.value());
+					}
+					else if (watcher->HasChanged()) this->Reload(db.value());
+
+				}
+				catch (...) {
+					watcher.reset();
+					db.reset();
+					if (onError) onError(std::current_exception());
+				}
+
+				std::unique_lock<std::mutex> lock(this->m_refreshMutex);
+				this->m_refreshSignal.wait_for(lock, token, interval, [] { return false; });
+
+			}
+
+		});
+
+	}
+
+	template <typename Key, typename... Columns>
+	inline auto TableSnapshot<Key, std::tuple<Columns...>>::StopRefresh() -> void {
+
+		if (!this->m_refresher.joinable()) return;
+
+		this->m_refresher.request_stop();
+		this->m_refresher.join();
+
+	}
+
+}
+
+#endif // __VSQLITE3_TABLESNAPSHOT_HPP__
@@ -20,6 +20,16 @@
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
+#include <new>
+#include <chrono>
+#include <thread>
+#include <streambuf>
+#include <exception>
+#include <memory>
+#include <map>
+#include <initializer_list>
+#include <utility>
+#include <cctype>
 
 #ifdef VSQLITE_USE_WINSQLITE
 #include <winsqlite/winsqlite3.h>
@@ -157,6 +167,23 @@ namespace Vsqlite3 {
 		return (this->m_extendedErrorCode & 0xFF);
 	}
 
+	inline auto QuoteIdentifier(const std::string_view identifier) -> std::string {
+
+		std::string quoted = "\"";
+		quoted.reserve(identifier.size() + 2);
+
+		for (const char ch : identifier) {
+			if (ch == '"') quoted += '"';
+			quoted += ch;
+		}
+
+		return (quoted + '"');
+	}
+
+	inline auto IsSameIdentifier(const std::string_view lhs, const std::string_view rhs) -> bool {
+		return ((lhs.size() == rhs.size()) && (sqlite3_strnicmp(lhs.data(), rhs.data(), static_cast<int>(lhs.size())) == 0));
+	}
+
 	enum class DatabaseOpenFlags : int {
 
 		None = 0,
@@ -210,34 +237,267 @@ namespace Vsqlite3 {
 		return static_cast<DatabaseOpenFlags>(~static_cast<T>(rhs));
 	}
 
+#ifndef SQLITE_OMIT_DESERIALIZE
+
+	enum class DeserializeFlags : unsigned int {
+
+		None = 0,
+
+		ReadOnly = SQLITE_DESERIALIZE_READONLY,
+		Resizeable = SQLITE_DESERIALIZE_RESIZEABLE
+
+	};
+
+	inline constexpr auto operator| (const DeserializeFlags lhs, const DeserializeFlags rhs) -> DeserializeFlags {
+		using T = std::underlying_type_t<DeserializeFlags>;
+		return static_cast<DeserializeFlags>(static_cast<T>(lhs) | static_cast<T>(rhs));
+	}
+
+	inline constexpr auto operator|= (DeserializeFlags& lhs, const DeserializeFlags rhs) -> DeserializeFlags& {
+		lhs = (lhs | rhs);
+		return lhs;
+	}
+
+	inline constexpr auto operator& (const DeserializeFlags lhs, const DeserializeFlags rhs) -> DeserializeFlags {
+		using T = std::underlying_type_t<DeserializeFlags>;
+		return static_cast<DeserializeFlags>(static_cast<T>(lhs) & static_cast<T>(rhs));
+	}
+
+	inline constexpr auto operator&= (DeserializeFlags& lhs, const DeserializeFlags rhs) -> DeserializeFlags& {
+		lhs = (lhs & rhs);
+		return lhs;
+	}
+
+	inline constexpr auto operator^ (const DeserializeFlags lhs, const DeserializeFlags rhs) -> DeserializeFlags {
+		using T = std::underlying_type_t<DeserializeFlags>;
+		return static_cast<DeserializeFlags>(static_cast<T>(lhs) ^ static_cast<T>(rhs));
+	}
+
+	inline constexpr auto operator^= (DeserializeFlags& lhs, const DeserializeFlags rhs) -> DeserializeFlags& {
+		lhs = (lhs ^ rhs);
+		return lhs;
+	}
+
+	inline constexpr auto operator~ (const DeserializeFlags rhs) -> DeserializeFlags {
+		using T = std::underlying_type_t<DeserializeFlags>;
+		return static_cast<DeserializeFlags>(~static_cast<T>(rhs));
+	}
+
+#endif // SQLITE_OMIT_DESERIALIZE
+
 	class Statement;
+	class DataVersionWatcher;
+
+	enum class ChangeOperation : int {
+		Insert = SQLITE_INSERT,
+		Update = SQLITE_UPDATE,
+		Delete = SQLITE_DELETE
+	};
+
+	struct ChangeEvent {
+		ChangeOperation operation;
+		std::string schema;
+		std::string table;
+		sqlite3_int64 rowid;
+	};
+
+	using ChangeCallback = std::function<void(const std::span<const ChangeEvent> events)>;
+
+	class ChangeBus {
+
+	public:
+		ChangeBus(void);
+		ChangeBus(const ChangeBus&) = delete;
+
+		auto operator= (const ChangeBus&) -> ChangeBus& = delete;
+
+		auto Subscribe(sqlite3* const pDb, const std::optional<std::string_view> table, const std::optional<ChangeOperation> operation, ChangeCallback callback) -> std::uint64_t;
+		auto Unsubscribe(sqlite3* const pDb, const std::uint64_t subscription) -> void;
+
+		auto HasReadyEvents(void) const -> bool;
+		auto Dispatch(void) -> void;
+
+		auto PendingCount(void) const -> std::size_t;
+		auto DiscardPending(const std::size_t count) -> void;
+
+	private:
+		struct Subscription {
+			std::optional<std::string> table;
+			std::optional<ChangeOperation> operation;
+			ChangeCallback callback;
+		};
+
+		std::map<std::uint64_t, Subscription> m_subscriptions;
+		std::uint64_t m_nextSubscription;
+		std::vector<ChangeEvent> m_pending;
+		std::vector<ChangeEvent> m_ready;
+
+		static auto OnUpdate(void* pCtx, int operation, const char* zSchema, const char* zTable, sqlite3_int64 rowid) -> void;
+		static auto OnCommit(void* pCtx) -> int;
+		static auto OnRollback(void* pCtx) -> void;
+
+	};
+
+	inline ChangeBus::ChangeBus() : m_nextSubscription(1) { }
+
+	inline auto ChangeBus::Subscribe(sqlite3* const pDb, const std::optional<std::string_view> table, const std::optional<ChangeOperation> operation, ChangeCallback callback) -> std::uint64_t {
+
+		if (!callback)
+			throw std::invalid_argument("'callback': Empty function.");
+
+		if (this->m_subscriptions.empty()) {
+			sqlite3_update_hook(pDb, &ChangeBus::OnUpdate, this);
+			sqlite3_commit_hook(pDb, &ChangeBus::OnCommit, this);
+			sqlite3_rollback_hook(pDb, &ChangeBus::OnRollback, this);
+		}
+
+		const std::uint64_t id = this->m_nextSubscription++;
+		this->m_subscriptions.emplace(id, Subscription { std::optional<std::string> { table }, operation, std::move(callback) });
+
+		return id;
+	}
+
+	inline auto ChangeBus::Unsubscribe(sqlite3* const pDb, const std::uint64_t subscription) -> void {
+
+		this->m_subscriptions.erase(subscription);
+
+		if (this->m_subscriptions.empty()) {
+			sqlite3_update_hook(pDb, nullptr, nullptr);
+			sqlite3_commit_hook(pDb, nullptr, nullptr);
+			sqlite3_rollback_hook(pDb, nullptr, nullptr);
+			this->m_pending.clear();
+			this->m_ready.clear();
+		}
+
+	}
+
+	inline auto ChangeBus::HasReadyEvents() const -> bool {
+		return !this->m_ready.empty();
+	}
+
+	inline auto ChangeBus::Dispatch() -> void {
+
+		if (this->m_ready.empty()) return;
+
+		std::vector<ChangeEvent> events;
+		events.swap(this->m_ready);
+
+		std::vector<std::uint64_t> ids;
+		ids.reserve(this->m_subscriptions.size());
+		for (const auto& [id, subscription] : this->m_subscriptions) ids.push_back(id);
+
+		std::vector<ChangeEvent> batch;
+		for (const std::uint64_t id : ids) {
+
+			const auto it = this->m_subscriptions.find(id);
+			if (it == this->m_subscriptions.end()) continue;
+
+			const Subscription& subscription = it->second;
+			const ChangeCallback callback = subscription.callback;
+
+			if (!subscription.table.has_value() && !subscription.operation.has_value()) {
+				callback(events);
+				continue;
+			}
+
+			batch.clear();
+			for (const ChangeEvent& event : events) {
+				if (subscription.table.has_value() && !IsSameIdentifier(subscription.table.value(), event.table)) continue;
+				if (subscription.operation.has_value() && (subscription.operation.value() != event.operation)) continue;
+				batch.push_back(event);
+			}
+
+			if (!batch.empty())
+				callback(batch);
+
+		}
+
+	}
+
+	inline auto ChangeBus::PendingCount() const -> std::size_t {
+		return this->m_pending.size();
+	}
+
+	inline auto ChangeBus::DiscardPending(const std::size_t count) -> void {
+		if (count < this->m_pending.size())
+			this->m_pending.resize(count);
+	}
+
+	inline auto ChangeBus::OnUpdate(void* pCtx, int operation, const char* zSchema, const char* zTable, sqlite3_int64 rowid) -> void {
+		ChangeBus* const pBus = static_cast<ChangeBus*>(pCtx);
+		pBus->m_pending.push_back({ static_cast<ChangeOperation>(operation), zSchema, zTable, rowid });
+	}
+
+	inline auto ChangeBus::OnCommit(void* pCtx) -> int {
+
+		ChangeBus* const pBus = static_cast<ChangeBus*>(pCtx);
+
+		if (pBus->m_ready.empty()) pBus->m_ready.swap(pBus->m_pending);
+		else {
+			pBus->m_ready.insert(pBus->m_ready.end(), std::make_move_iterator(pBus->m_pending.begin()), std::make_move_iterator(pBus->m_pending.end()));
+			pBus->m_pending.clear();
+		}
+
+		return 0;
+	}
+
+	inline auto ChangeBus::OnRollback(void* pCtx) -> void {
+		static_cast<ChangeBus*>(pCtx)->m_pending.clear();
+	}
 
 	class Database {
 
 	public:
-		Database(const std::optional<std::string_view> filename, const DatabaseOpenFlags flags);
+		Database(const std::optional<std::string_view> filename, const DatabaseOpenFlags flags, const std::optional<std::string_view> vfs = std::nullopt);
 
 		auto ConnectionHandle(void) const -> sqlite3*;
 
+		auto SetBusyTimeout(const std::chrono::milliseconds timeout) -> void;
+
+		auto Changes(void) const -> sqlite3_int64;
+		auto TotalChanges(void) const -> sqlite3_int64;
+		auto LastInsertRowId(void) const -> sqlite3_int64;
+
+#ifndef SQLITE_OMIT_DESERIALIZE
+		auto Serialize(const std::string_view schema = "main") const -> std::vector<std::uint8_t>;
+		auto SerializeNoCopy(const std::string_view schema = "main") const -> std::optional<std::span<const std::uint8_t>>;
+		auto Deserialize(const std::span<const std::uint8_t> buffer, const DeserializeFlags flags = DeserializeFlags::Resizeable, const std::string_view schema = "main") -> void;
+		auto DeserializeNoCopy(const std::span<const std::uint8_t> buffer, const std::string_view schema = "main") -> void;
+#endif // SQLITE_OMIT_DESERIALIZE
+
+		auto Subscribe(const std::optional<std::string_view> table, const std::optional<ChangeOperation> operation, ChangeCallback callback) -> std::uint64_t;
+		auto Unsubscribe(const std::uint64_t subscription) -> void;
+		auto DispatchChanges(void) -> void;
+		auto ChangeMark(void) const -> std::size_t;
+		auto DiscardChanges(const std::size_t mark) -> void;
+
+		auto HasChangedSinceLastCheck(void) -> bool;
+
 		auto PrepareStatement(const std::string_view sql) -> Statement;
 
 		template <typename... Args>
 		auto Execute(const std::string_view sql, const Args&... args) -> void;
 
 	private:
+		std::shared_ptr<ChangeBus> m_changeBus;
 		Handle<sqlite3*, nullptr> m_db;
+		std::shared_ptr<DataVersionWatcher> m_dataVersion;
+
+		friend class Statement;
 
 	};
 
-	inline Database::Database(const std::optional<std::string_view> filename, const DatabaseOpenFlags flags) {
+	inline Database::Database(const std::optional<std::string_view> filename, const DatabaseOpenFlags flags, const std::optional<std::string_view> vfs) {
 
+		this->m_changeBus = std::make_shared<ChangeBus>();
 		this->m_db = { nullptr, &sqlite3_close_v2 };
 
+		const std::optional<std::string> vfsName { vfs };
 		const int res = sqlite3_open_v2(
 			filename.value_or(":memory:").data(),
 			this->m_db.GetAddressOf(),
 			static_cast<int>(flags),
-			nullptr
+			(vfsName.has_value() ? vfsName->c_str() : nullptr)
 		);
 
 		if (res != SQLITE_OK)
@@ -249,6 +509,133 @@ namespace Vsqlite3 {
 		return this->m_db.Get();
 	}
 
+	inline auto Database::SetBusyTimeout(const std::chrono::milliseconds timeout) -> void {
+
+		const int res = sqlite3_busy_timeout(this->ConnectionHandle(), static_cast<int>(timeout.count()));
+		if (res != SQLITE_OK)
+			throw SqliteException { this->ConnectionHandle() };
+
+	}
+
+	inline auto Database::Changes() const -> sqlite3_int64 {
+		return sqlite3_changes64(this->ConnectionHandle());
+	}
+
+	inline auto Database::TotalChanges() const -> sqlite3_int64 {
+		return sqlite3_total_changes64(this->ConnectionHandle());
+	}
+
+	inline auto Database::LastInsertRowId() const -> sqlite3_int64 {
+		return sqlite3_last_insert_rowid(this->ConnectionHandle());
+	}
+
+	inline auto Database::Subscribe(const std::optional<std::string_view> table, const std::optional<ChangeOperation> operation, ChangeCallback callback) -> std::uint64_t {
+		return this->m_changeBus->Subscribe(this->ConnectionHandle(), table, operation, std::move(callback));
+	}
+
+	inline auto Database::Unsubscribe(const std::uint64_t subscription) -> void {
+		this->m_changeBus->Unsubscribe(this->ConnectionHandle(), subscription);
+	}
+
+	inline auto Database::DispatchChanges() -> void {
+		this->m_changeBus->Dispatch();
+	}
+
+	inline auto Database::ChangeMark() const -> std::size_t {
+		return this->m_changeBus->PendingCount();
+	}
+
+	inline auto Database::DiscardChanges(const std::size_t mark) -> void {
+
+		// ROLLBACK TO does not invoke the rollback hook, so the events of the rows it undid would
+		// otherwise be delivered when the enclosing transaction commits.
+
+		this->m_changeBus->DiscardPending(mark);
+
+	}
+
+#ifndef SQLITE_OMIT_DESERIALIZE
+
+	inline auto Database::Serialize(const std::string_view schema) const -> std::vector<std::uint8_t> {
+
+		const std::string schemaName { schema };
+		sqlite3_int64 size = 0;
+
+		Handle<unsigned char*, nullptr> data = {
+			sqlite3_serialize(this->ConnectionHandle(), schemaName.c_str(), &size, 0),
+			&sqlite3_free
+		};
+
+		if (data.Get() == nullptr) {
+			if (sqlite3_errcode(this->ConnectionHandle()) == SQLITE_NOMEM) throw std::bad_alloc();
+			throw std::invalid_argument("'schema': Database does not exist.");
+		}
+
+		return { data.Get(), (data.Get() + size) };
+	}
+
+	inline auto Database::SerializeNoCopy(const std::string_view schema) const -> std::optional<std::span<const std::uint8_t>> {
+
+		const std::string schemaName { schema };
+		sqlite3_int64 size = 0;
+
+		const unsigned char* pData = sqlite3_serialize(this->ConnectionHandle(), schemaName.c_str(), &size, SQLITE_SERIALIZE_NOCOPY);
+		if (pData == nullptr) return std::nullopt;
+
+		return std::span<const std::uint8_t> { pData, static_cast<std::size_t>(size) };
+	}
+
+	inline auto Database::Deserialize(const std::span<const std::uint8_t> buffer, const DeserializeFlags flags, const std::string_view schema) -> void {
+
+		const std::string schemaName { schema };
+
+		unsigned char* pData = static_cast<unsigned char*>(sqlite3_malloc64(std::max<sqlite3_uint64>(buffer.size(), 1)));
+		if (pData == nullptr) throw std::bad_alloc();
+
+		if (!buffer.empty())
+			std::memcpy(pData, buffer.data(), buffer.size());
+
+		const int res = sqlite3_deserialize(
+			this->ConnectionHandle(),
+			schemaName.c_str(),
+			pData,
+			static_cast<sqlite3_int64>(buffer.size()),
+			static_cast<sqlite3_int64>(buffer.size()),
+			(static_cast<unsigned int>(flags) | SQLITE_DESERIALIZE_FREEONCLOSE)
+		);
+
+		if (res != SQLITE_OK)
+			throw SqliteException { this->ConnectionHandle() };
+
+	}
+
+	inline auto Database::DeserializeNoCopy(const std::span<const std::uint8_t> buffer, const std::string_view schema) -> void {
+
+		if (buffer.empty())
+			throw std::invalid_argument("'buffer': Empty buffer.");
+
+		const std::string schemaName { schema };
+
+		const int res = sqlite3_deserialize(
+			this->ConnectionHandle(),
+			schemaName.c_str(),
+			const_cast<unsigned char*>(buffer.data()),
+			static_cast<sqlite3_int64>(buffer.size()),
+			static_cast<sqlite3_int64>(buffer.size()),
+			SQLITE_DESERIALIZE_READONLY
+		);
+
+		if (res != SQLITE_OK)
+			throw SqliteException { this->ConnectionHandle() };
+
+	}
+
+#endif // SQLITE_OMIT_DESERIALIZE
+
+	struct ZeroBlob {
+		std::uint64_t size;
+	};
+
 	template <typename T>
 	struct Binding {
 
@@ -424,6 +811,15 @@ namespace Vsqlite3 {
 
 	};
 
+	template <>
+	struct Binding<ZeroBlob> {
+
+		static inline auto Bind(sqlite3_stmt* const pStmt, const int index, const ZeroBlob arg) -> int {
+			return sqlite3_bind_zeroblob64(pStmt, index, static_cast<sqlite3_uint64>(arg.size));
+		}
+
+	};
+
 #endif // VSQLITE_NO_DEFAULT_BINDING_SPECIALIZATIONS
 
 	class Statement {
@@ -473,6 +869,7 @@ namespace Vsqlite3 {
 
 	private:
 		Handle<sqlite3_stmt*, nullptr> m_stmt;
+		std::shared_ptr<ChangeBus> m_changeBus;
 		bool m_canFetch;
 
 	};
@@ -492,6 +889,7 @@ namespace Vsqlite3 {
 			throw std::invalid_argument("'sql': Empty string.");
 
 		this->m_stmt = { nullptr, &sqlite3_finalize };
+		this->m_changeBus = db.m_changeBus;
 		this->m_canFetch = false;
 
 		const int res = sqlite3_prepare_v2(
@@ -529,6 +927,9 @@ namespace Vsqlite3 {
 
 		this->m_canFetch = (res == SQLITE_ROW);
 
+		if (this->m_changeBus->HasReadyEvents() && (sqlite3_get_autocommit(sqlite3_db_handle(this->StatementHandle())) != 0))
+			this->m_changeBus->Dispatch();
+
 	}
 
 	inline auto Statement::Unbind() -> void {
@@ -620,6 +1021,1052 @@ namespace Vsqlite3 {
 		return false;
 	}
 
+	class DataVersionWatcher {
+
+	public:
+		DataVersionWatcher(const Database& db, const std::string_view schema = "main");
+
+		auto DataVersion(void) -> std::int64_t;
+		auto HasChanged(void) -> bool;
+
+		auto OnChange(std::function<void(void)> callback) -> void;
+		auto Poll(void) -> bool;
+
+	private:
+		Statement m_stmt;
+		std::int64_t m_lastVersion;
+		std::vector<std::function<void(void)>> m_callbacks;
+
+	};
+
+	inline DataVersionWatcher::DataVersionWatcher(const Database& db, const std::string_view schema)
+		: m_stmt(db, ("PRAGMA " + QuoteIdentifier(schema) + ".data_version;")), m_lastVersion(0) {
+
+		this->m_lastVersion = this->DataVersion();
+
+	}
+
+	inline auto DataVersionWatcher::DataVersion() -> std::int64_t {
+
+		std::int64_t version = 0;
+
+		this->m_stmt.Reset();
+		this->m_stmt.Step();
+		this->m_stmt.Column(version);
+		this->m_stmt.Reset();
+
+		return version;
+	}
+
+	inline auto DataVersionWatcher::HasChanged() -> bool {
+
+		const std::int64_t version = this->DataVersion();
+		if (version == this->m_lastVersion) return false;
+
+		this->m_lastVersion = version;
+
+		return true;
+	}
+
+	inline auto DataVersionWatcher::OnChange(std::function<void(void)> callback) -> void {
+
+		if (!callback)
+			throw std::invalid_argument("'callback': Empty function.");
+
+		this->m_callbacks.push_back(std::move(callback));
+
+	}
+
+	inline auto DataVersionWatcher::Poll() -> bool {
+
+		if (!this->HasChanged()) return false;
+
+		for (const std::function<void(void)>& callback : this->m_callbacks)
+			callback();
+
+		return true;
+	}
+
+	inline auto Database::HasChangedSinceLastCheck() -> bool {
+
+		if (!this->m_dataVersion) {
+			this->m_dataVersion = std::make_shared<DataVersionWatcher>(*this);
+			return false;
+		}
+
+		return this->m_dataVersion->HasChanged();
+	}
+
+	class Blob {
+
+	public:
+		Blob(const Database& db, const std::string_view table, const std::string_view column, const sqlite3_int64 rowid, const bool writable = false, const std::string_view schema = "main");
+
+		auto BlobHandle(void) const -> sqlite3_blob*;
+
+		auto Size(void) const -> std::size_t;
+		auto Read(const std::span<std::uint8_t> buffer, const std::size_t offset = 0) const -> std::size_t;
+		auto Write(const std::span<const std::uint8_t> buffer, const std::size_t offset = 0) -> void;
+
+		auto Reopen(const sqlite3_int64 rowid) -> void;
+		auto Close(void) -> void;
+
+		static auto Insert(Database& db, const std::string_view table, const std::string_view column, const std::uint64_t size, const std::string_view schema = "main") -> Blob;
+
+	private:
+		Handle<sqlite3_blob*, nullptr> m_blob;
+		sqlite3* m_pDb;
+
+	};
+
+	inline Blob::Blob(const Database& db, const std::string_view table, const std::string_view column, const sqlite3_int64 rowid, const bool writable, const std::string_view schema) {
+
+		const std::string schemaName { schema };
+		const std::string tableName { table };
+		const std::string columnName { column };
+
+		this->m_blob = { nullptr, &sqlite3_blob_close };
+		this->m_pDb = db.ConnectionHandle();
+
+		const int res = sqlite3_blob_open(
+			this->m_pDb,
+			schemaName.c_str(),
+			tableName.c_str(),
+			columnName.c_str(),
+			rowid,
+			(writable ? 1 : 0),
+			this->m_blob.GetAddressOf()
+		);
+
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDb };
+
+	}
+
+	inline auto Blob::BlobHandle() const -> sqlite3_blob* {
+		return this->m_blob.Get();
+	}
+
+	inline auto Blob::Size() const -> std::size_t {
+		return static_cast<std::size_t>(sqlite3_blob_bytes(this->BlobHandle()));
+	}
+
+	inline auto Blob::Read(const std::span<std::uint8_t> buffer, const std::size_t offset) const -> std::size_t {
+
+		const std::size_t size = this->Size();
+		if (offset >= size) return 0;
+
+		const std::size_t len = std::min(buffer.size(), (size - offset));
+		const int res = sqlite3_blob_read(this->BlobHandle(), buffer.data(), static_cast<int>(len), static_cast<int>(offset));
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDb };
+
+		return len;
+	}
+
+	inline auto Blob::Write(const std::span<const std::uint8_t> buffer, const std::size_t offset) -> void {
+
+		if ((offset + buffer.size()) > this->Size())
+			throw std::out_of_range("'buffer': Write exceeds the size of the blob.");
+
+		const int res = sqlite3_blob_write(this->BlobHandle(), buffer.data(), static_cast<int>(buffer.size()), static_cast<int>(offset));
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDb };
+
+	}
+
+	inline auto Blob::Reopen(const sqlite3_int64 rowid) -> void {
+
+		const int res = sqlite3_blob_reopen(this->BlobHandle(), rowid);
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDb };
+
+	}
+
+	inline auto Blob::Close() -> void {
+
+		sqlite3_blob* const pBlob = this->m_blob.Get();
+		this->m_blob.Reset();
+
+		const int res = sqlite3_blob_close(pBlob);
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDb };
+
+	}
+
+	inline auto Blob::Insert(Database& db, const std::string_view table, const std::string_view column, const std::uint64_t size, const std::string_view schema) -> Blob {
+
+		const std::string sql = (
+			"INSERT INTO " + QuoteIdentifier(schema) + "." + QuoteIdentifier(table) +
+			" (" + QuoteIdentifier(column) + ") VALUES (?);"
+		);
+
+		db.Execute(sql, ZeroBlob { size });
+
+		return { db, table, column, sqlite3_last_insert_rowid(db.ConnectionHandle()), true, schema };
+	}
+
+	enum class KvStatus : int {
+		Found,
+		Missing,
+		Null
+	};
+
+	class KvReader {
+
+	public:
+		KvReader(const Database& db, const std::string_view table, const std::string_view column, const std::string_view schema = "main");
+
+		auto Get(const sqlite3_int64 rowid, const std::span<std::uint8_t> buffer, std::size_t& length) -> KvStatus;
+		auto Release(void) -> void;
+
+	private:
+		const Database* m_pDb;
+		std::string m_schema;
+		std::string m_table;
+		std::string m_column;
+		std::optional<Blob> m_blob;
+		std::optional<Statement> m_probe;
+
+		auto Classify(const sqlite3_int64 rowid) -> KvStatus;
+
+	};
+
+	inline KvReader::KvReader(const Database& db, const std::string_view table, const std::string_view column, const std::string_view schema)
+		: m_pDb(&db), m_schema(schema), m_table(table), m_column(column) { }
+
+	inline auto KvReader::Get(const sqlite3_int64 rowid, const std::span<std::uint8_t> buffer, std::size_t& length) -> KvStatus {
+
+		length = 0;
+
+		if (this->m_blob.has_value()) {
+
+			const int res = sqlite3_blob_reopen(this->m_blob->BlobHandle(), rowid);
+			if (res == SQLITE_OK) {
+				length = this->m_blob->Read(buffer);
+				return KvStatus::Found;
+			}
+
+			this->m_blob.reset();
+
+			if (res == SQLITE_ERROR) return this->Classify(rowid);
+			if (res != SQLITE_ABORT) throw SqliteException { this->m_pDb->ConnectionHandle() };
+
+		}
+
+		try { this->m_blob.emplace(*this->m_pDb, this->m_table, this->m_column, rowid, false, this->m_schema); }
+		catch (const SqliteException& ex) {
+			if (ex.GetPrimaryErrorCode() == SQLITE_ERROR) return this->Classify(rowid);
+			throw;
+		}
+
+		length = this->m_blob->Read(buffer);
+		return KvStatus::Found;
+	}
+
+	inline auto KvReader::Release() -> void {
+		this->m_blob.reset();
+	}
+
+	inline auto KvReader::Classify(const sqlite3_int64 rowid) -> KvStatus {
+
+		// sqlite3_blob_open and sqlite3_blob_reopen fail with SQLITE_ERROR both for a missing row and
+		// for a value that is not TEXT or BLOB, so the row is looked up to tell the two apart. This
+		// only runs on the miss path.
+
+		if (!this->m_probe.has_value()) {
+
+			const std::string sql = (
+				"SELECT typeof(" + QuoteIdentifier(this->m_column) + ") FROM " +
+				QuoteIdentifier(this->m_schema) + "." + QuoteIdentifier(this->m_table) + " WHERE rowid = ?;"
+			);
+
+			this->m_probe.emplace(*this->m_pDb, sql);
+
+		}
+
+		Statement& probe = this->m_probe.value();
+		probe.Reset();
+		probe.Bind(rowid);
+
+		std::string type;
+		const bool found = probe.Fetch(type);
+		probe.Reset();
+
+		if (!found) return KvStatus::Missing;
+		if (type == "null") return KvStatus::Null;
+
+		throw SqliteException { ("cannot open value of type " + type), SQLITE_MISMATCH };
+	}
+
+	class BlobStreamBuffer : public std::streambuf {
+
+	public:
+		BlobStreamBuffer(Blob& blob, const std::size_t bufferSize = (64 * 1024));
+		BlobStreamBuffer(const BlobStreamBuffer&) = delete;
+		~BlobStreamBuffer(void);
+
+		auto operator= (const BlobStreamBuffer&) -> BlobStreamBuffer& = delete;
+
+	protected:
+		auto underflow(void) -> int_type override;
+		auto overflow(int_type ch) -> int_type override;
+		auto sync(void) -> int override;
+		auto seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) -> pos_type override;
+		auto seekpos(pos_type pos, std::ios_base::openmode which) -> pos_type override;
+
+	private:
+		Blob* m_pBlob;
+		std::vector<char> m_buffer;
+		std::size_t m_position;
+
+		auto CurrentPosition(void) const -> std::size_t;
+		auto Flush(void) -> void;
+
+	};
+
+	inline BlobStreamBuffer::BlobStreamBuffer(Blob& blob, const std::size_t bufferSize)
+		: m_pBlob(&blob), m_buffer(std::max<std::size_t>(bufferSize, 1)), m_position(0) { }
+
+	inline BlobStreamBuffer::~BlobStreamBuffer() {
+		try { this->Flush(); }
+		catch (...) { }
+	}
+
+	inline auto BlobStreamBuffer::CurrentPosition() const -> std::size_t {
+		if (this->gptr() != nullptr) return (this->m_position + static_cast<std::size_t>(this->gptr() - this->eback()));
+		if (this->pptr() != nullptr) return (this->m_position + static_cast<std::size_t>(this->pptr() - this->pbase()));
+		return this->m_position;
+	}
+
+	inline auto BlobStreamBuffer::Flush() -> void {
+
+		if ((this->pbase() != nullptr) && (this->pptr() > this->pbase())) {
+			const std::span<const std::uint8_t> pending = {
+				reinterpret_cast<const std::uint8_t*>(this->pbase()),
+				static_cast<std::size_t>(this->pptr() - this->pbase())
+			};
+			this->m_pBlob->Write(pending, this->m_position);
+		}
+
+		this->m_position = this->CurrentPosition();
+		this->setg(nullptr, nullptr, nullptr);
+		this->setp(nullptr, nullptr);
+
+	}
+
+	inline auto BlobStreamBuffer::underflow() -> int_type {
+
+		if ((this->gptr() != nullptr) && (this->gptr() < this->egptr()))
+			return traits_type::to_int_type(*this->gptr());
+
+		this->Flush();
+
+		const std::span<std::uint8_t> buffer = { reinterpret_cast<std::uint8_t*>(this->m_buffer.data()), this->m_buffer.size() };
+		const std::size_t len = this->m_pBlob->Read(buffer, this->m_position);
+		if (len == 0) return traits_type::eof();
+
+		this->setg(this->m_buffer.data(), this->m_buffer.data(), (this->m_buffer.data() + len));
+
+		return traits_type::to_int_type(*this->gptr());
+	}
+
+	inline auto BlobStreamBuffer::overflow(int_type ch) -> int_type {
+
+		this->Flush();
+
+		const std::size_t size = this->m_pBlob->Size();
+		const std::size_t available = ((this->m_position < size) ? (size - this->m_position) : 0);
+		if (available == 0) return traits_type::eof();
+
+		this->setp(this->m_buffer.data(), (this->m_buffer.data() + std::min(available, this->m_buffer.size())));
+
+		if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+			*this->pptr() = traits_type::to_char_type(ch);
+			this->pbump(1);
+		}
+
+		return traits_type::not_eof(ch);
+	}
+
+	inline auto BlobStreamBuffer::sync() -> int {
+
+		try { this->Flush(); }
+		catch (const SqliteException&) { return -1; }
+
+		return 0;
+	}
+
+	inline auto BlobStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) -> pos_type {
+
+		this->Flush();
+
+		const off_type size = static_cast<off_type>(this->m_pBlob->Size());
+		off_type base = 0;
+		if (dir == std::ios_base::cur) base = static_cast<off_type>(this->m_position);
+		else if (dir == std::ios_base::end) base = size;
+
+		const off_type position = (base + off);
+		if ((position < 0) || (position > size))
+			return pos_type(off_type(-1));
+
+		this->m_position = static_cast<std::size_t>(position);
+
+		return pos_type(position);
+	}
+
+	inline auto BlobStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which) -> pos_type {
+		return this->seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+
+	class SharedMemoryDatabase {
+
+	public:
+		SharedMemoryDatabase(const std::string_view name, const std::optional<sqlite3_int64> maxSize = std::nullopt);
+
+		auto Name(void) const -> std::string_view;
+		auto Uri(void) const -> std::string_view;
+		auto Owner(void) -> Database&;
+
+		auto Connect(const DatabaseOpenFlags flags = DatabaseOpenFlags::ReadWrite) const -> Database;
+
+	private:
+		std::string m_name;
+		std::string m_uri;
+		Database m_owner;
+
+		static auto MakeUri(const std::string_view name) -> std::string;
+
+	};
+
+	inline SharedMemoryDatabase::SharedMemoryDatabase(const std::string_view name, const std::optional<sqlite3_int64> maxSize)
+		: m_name(name), m_uri(SharedMemoryDatabase::MakeUri(name)),
+		  m_owner(m_uri, (DatabaseOpenFlags::ReadWrite | DatabaseOpenFlags::Create | DatabaseOpenFlags::Uri)) {
+
+		if (maxSize.has_value()) {
+
+			sqlite3_int64 limit = maxSize.value();
+			const int res = sqlite3_file_control(this->m_owner.ConnectionHandle(), "main", SQLITE_FCNTL_SIZE_LIMIT, &limit);
+			if (res != SQLITE_OK)
+				throw SqliteException { sqlite3_errstr(res), res };
+
+		}
+
+	}
+
+	inline auto SharedMemoryDatabase::Name() const -> std::string_view {
+		return this->m_name;
+	}
+
+	inline auto SharedMemoryDatabase::Uri() const -> std::string_view {
+		return this->m_uri;
+	}
+
+	inline auto SharedMemoryDatabase::Owner() -> Database& {
+		return this->m_owner;
+	}
+
+	inline auto SharedMemoryDatabase::Connect(const DatabaseOpenFlags flags) const -> Database {
+		return { this->m_uri, ((flags & ~DatabaseOpenFlags::Create) | DatabaseOpenFlags::Uri) };
+	}
+
+	inline auto SharedMemoryDatabase::MakeUri(const std::string_view name) -> std::string {
+
+		if (name.empty())
+			throw std::invalid_argument("'name': Empty string.");
+
+		if (name.find_first_of("/?#&%") != std::string_view::npos)
+			throw std::invalid_argument("'name': Name contains reserved URI characters.");
+
+		return ("file:/" + std::string(name) + "?vfs=memdb");
+	}
+
+	struct BackupOptions {
+		int pagesPerStep = 256;
+		std::chrono::milliseconds sleep = std::chrono::milliseconds(0);
+		std::size_t maxBytesPerSecond = 0;
+		std::function<void(const int remaining, const int pageCount)> progress;
+	};
+
+	class Backup {
+
+	public:
+		Backup(Database& destination, const Database& source, const std::string_view destinationName = "main", const std::string_view sourceName = "main");
+
+		auto BackupHandle(void) const -> sqlite3_backup*;
+
+		auto Step(const int pages = -1) -> bool;
+		auto Remaining(void) const -> int;
+		auto PageCount(void) const -> int;
+		auto Finish(void) -> void;
+
+		auto Run(const BackupOptions& options = { }) -> void;
+
+	private:
+		Handle<sqlite3_backup*, nullptr> m_backup;
+		sqlite3* m_pDestination;
+		int m_pageSize;
+
+	};
+
+	inline Backup::Backup(Database& destination, const Database& source, const std::string_view destinationName, const std::string_view sourceName) {
+
+		const std::string destinationSchema { destinationName };
+		const std::string sourceSchema { sourceName };
+
+		this->m_pDestination = destination.ConnectionHandle();
+		this->m_pageSize = 0;
+
+		Statement stmt = { source, ("PRAGMA " + QuoteIdentifier(sourceSchema) + ".page_size;") };
+		stmt.Fetch(this->m_pageSize);
+
+		sqlite3_backup* const pBackup = sqlite3_backup_init(
+			this->m_pDestination,
+			destinationSchema.c_str(),
+			source.ConnectionHandle(),
+			sourceSchema.c_str()
+		);
+
+		if (pBackup == nullptr)
+			throw SqliteException { this->m_pDestination };
+
+		this->m_backup = { pBackup, &sqlite3_backup_finish };
+
+	}
+
+	inline auto Backup::BackupHandle() const -> sqlite3_backup* {
+		return this->m_backup.Get();
+	}
+
+	inline auto Backup::Step(const int pages) -> bool {
+
+		const int res = sqlite3_backup_step(this->BackupHandle(), pages);
+		if (res == SQLITE_DONE) return false;
+
+		if ((res != SQLITE_OK) && (res != SQLITE_BUSY) && (res != SQLITE_LOCKED))
+			throw SqliteException { sqlite3_errstr(res), res };
+
+		return true;
+	}
+
+	inline auto Backup::Remaining() const -> int {
+		return sqlite3_backup_remaining(this->BackupHandle());
+	}
+
+	inline auto Backup::PageCount() const -> int {
+		return sqlite3_backup_pagecount(this->BackupHandle());
+	}
+
+	inline auto Backup::Finish() -> void {
+
+		sqlite3_backup* const pBackup = this->m_backup.Get();
+		this->m_backup.Reset();
+
+		const int res = sqlite3_backup_finish(pBackup);
+		if (res != SQLITE_OK)
+			throw SqliteException { this->m_pDestination };
+
+	}
+
+	inline auto Backup::Run(const BackupOptions& options) -> void {
+
+		if (options.pagesPerStep == 0)
+			throw std::invalid_argument("'options': Pages per step cannot be zero.");
+
+		while (true) {
+
+			const auto start = std::chrono::steady_clock::now();
+			const int remaining = this->Remaining();
+			const bool more = this->Step(options.pagesPerStep);
+
+			if (options.progress)
+				options.progress(this->Remaining(), this->PageCount());
+
+			if (!more) break;
+
+			std::chrono::microseconds delay = options.sleep;
+
+			if ((options.maxBytesPerSecond != 0) && (options.pagesPerStep > 0)) {
+
+				const std::size_t bytes = (static_cast<std::size_t>(options.pagesPerStep) * static_cast<std::size_t>(this->m_pageSize));
+				const std::chrono::microseconds budget { static_cast<std::int64_t>((bytes * 1000000.0) / options.maxBytesPerSecond) };
+				const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+				delay = std::max(delay, (budget - elapsed));
+
+			}
+
+			// A step that copied nothing hit SQLITE_BUSY or SQLITE_LOCKED. Retrying immediately would
+			// spin against the lock holder, so wait at least a little before the next attempt.
+
+			if (this->Remaining() == remaining)
+				delay = std::max<std::chrono::microseconds>(delay, std::chrono::milliseconds(10));
+
+			if (delay.count() > 0)
+				std::this_thread::sleep_for(delay);
+
+		}
+
+		this->Finish();
+
+	}
+
+	class PragmaScope {
+
+	public:
+		PragmaScope(Database& db, const std::initializer_list<std::pair<std::string_view, std::string_view>> pragmas, const std::string_view schema = "main");
+		PragmaScope(Database& db, const std::span<const std::pair<std::string_view, std::string_view>> pragmas, const std::string_view schema = "main");
+		PragmaScope(const PragmaScope&) = delete;
+		PragmaScope(PragmaScope&& other) noexcept;
+		~PragmaScope(void);
+
+		auto operator= (const PragmaScope&) -> PragmaScope& = delete;
+		auto operator= (PragmaScope&&) -> PragmaScope& = delete;
+
+		auto Restore(void) -> bool;
+
+		static auto BulkLoad(Database& db, const std::string_view schema = "main") -> PragmaScope;
+
+	private:
+		Database* m_pDb;
+		std::string m_schema;
+		std::vector<std::pair<std::string, std::string>> m_previous;
+
+		static auto HasTempObjects(Database& db) -> bool;
+
+	};
+
+	inline PragmaScope::PragmaScope(Database& db, const std::initializer_list<std::pair<std::string_view, std::string_view>> pragmas, const std::string_view schema)
+		: PragmaScope(db, std::span<const std::pair<std::string_view, std::string_view>> { pragmas.begin(), pragmas.size() }, schema) { }
+
+	inline PragmaScope::PragmaScope(Database& db, const std::span<const std::pair<std::string_view, std::string_view>> pragmas, const std::string_view schema)
+		: m_pDb(&db), m_schema(QuoteIdentifier(schema)) {
+
+		try {
+
+			for (const auto& [name, value] : pragmas) {
+
+				if (name.empty() || !std::all_of(name.begin(), name.end(), [](const char ch) { return (std::isalnum(static_cast<unsigned char>(ch)) || (ch == '_')); }))
+					throw std::invalid_argument("'pragmas': Invalid pragma name.");
+
+				const std::string pragma = ("PRAGMA " + this->m_schema + "." + std::string(name));
+
+				std::string previous;
+				Statement stmt = { db, (pragma + ";") };
+				if (!stmt.Fetch(previous))
+					throw std::invalid_argument("'pragmas': Pragma does not return its current value.");
+
+				stmt.Reset();
+
+				db.Execute(pragma + " = " + std::string(value) + ";");
+				this->m_previous.emplace_back(std::string(name), std::move(previous));
+
+			}
+
+		}
+		catch (...) {
+			try { this->Restore(); }
+			catch (...) { }
+			throw;
+		}
+
+	}
+
+	inline PragmaScope::PragmaScope(PragmaScope&& other) noexcept
+		: m_pDb(other.m_pDb), m_schema(std::move(other.m_schema)), m_previous(std::move(other.m_previous)) {
+		other.m_previous.clear();
+	}
+
+	inline PragmaScope::~PragmaScope() {
+		try { this->Restore(); }
+		catch (...) { }
+	}
+
+	inline auto PragmaScope::Restore() -> bool {
+
+		bool restored = true;
+
+		while (!this->m_previous.empty()) {
+
+			const auto [name, value] = std::move(this->m_previous.back());
+			this->m_previous.pop_back();
+
+			// Changing temp_store drops every TEMP table; ones created while the scope was active
+			// are worth more than the previous setting. The caller learns about it from the return
+			// value.
+
+			if ((name == "temp_store") && PragmaScope::HasTempObjects(*this->m_pDb)) {
+				restored = false;
+				continue;
+			}
+
+			this->m_pDb->Execute("PRAGMA " + this->m_schema + "." + name + " = " + QuoteIdentifier(value) + ";");
+
+		}
+
+		return restored;
+	}
+
+	inline auto PragmaScope::BulkLoad(Database& db, const std::string_view schema) -> PragmaScope {
+
+		// The safety level cannot be changed inside a transaction, and changing temp_store drops
+		// every TEMP table, so both are only touched outside a transaction and temp_store only when
+		// it would actually change and nothing lives in the temp schema.
+
+		std::vector<std::pair<std::string_view, std::string_view>> pragmas;
+
+		if (sqlite3_get_autocommit(db.ConnectionHandle()) != 0) {
+
+			pragmas.emplace_back("synchronous", "OFF");
+
+			std::int32_t tempStore = 0;
+			Statement stmt = { db, "PRAGMA temp_store;" };
+			stmt.Fetch(tempStore);
+			stmt.Reset();
+
+			if ((tempStore != 2) && !PragmaScope::HasTempObjects(db))
+				pragmas.emplace_back("temp_store", "MEMORY");
+
+		}
+
+		pragmas.emplace_back("cache_size", "-262144");
+
+		return PragmaScope { db, pragmas, schema };
+	}
+
+	inline auto PragmaScope::HasTempObjects(Database& db) -> bool {
+
+		std::int32_t exists = 0;
+		Statement stmt = { db, "SELECT EXISTS (SELECT 1 FROM temp.sqlite_schema);" };
+		stmt.Fetch(exists);
+
+		return (exists != 0);
+	}
+
+#if defined(SQLITE_ENABLE_SESSION) && defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+
+	enum class ChangesetOperation : int {
+		Insert = SQLITE_INSERT,
+		Update = SQLITE_UPDATE,
+		Delete = SQLITE_DELETE
+	};
+
+	enum class ChangesetConflict : int {
+		Data = SQLITE_CHANGESET_DATA,
+		NotFound = SQLITE_CHANGESET_NOTFOUND,
+		Conflict = SQLITE_CHANGESET_CONFLICT,
+		Constraint = SQLITE_CHANGESET_CONSTRAINT,
+		ForeignKey = SQLITE_CHANGESET_FOREIGN_KEY
+	};
+
+	enum class ChangesetConflictAction : int {
+		Omit = SQLITE_CHANGESET_OMIT,
+		Replace = SQLITE_CHANGESET_REPLACE,
+		Abort = SQLITE_CHANGESET_ABORT
+	};
+
+	class ChangesetEntry {
+
+	public:
+		ChangesetEntry(sqlite3_changeset_iter* const pIter);
+
+		auto IteratorHandle(void) const -> sqlite3_changeset_iter*;
+
+		auto Table(void) const -> std::string_view;
+		auto Operation(void) const -> ChangesetOperation;
+		auto ColumnCount(void) const -> int;
+		auto IsIndirect(void) const -> bool;
+
+		auto Old(const int column) const -> sqlite3_value*;
+		auto New(const int column) const -> sqlite3_value*;
+		auto Conflict(const int column) const -> sqlite3_value*;
+
+	private:
+		sqlite3_changeset_iter* m_pIter;
+		const char* m_pTable;
+		int m_columns;
+		int m_operation;
+		int m_indirect;
+
+	};
+
+	inline ChangesetEntry::ChangesetEntry(sqlite3_changeset_iter* const pIter) : m_pIter(pIter) {
+
+		const int res = sqlite3changeset_op(pIter, &this->m_pTable, &this->m_columns, &this->m_operation, &this->m_indirect);
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline auto ChangesetEntry::IteratorHandle() const -> sqlite3_changeset_iter* {
+		return this->m_pIter;
+	}
+
+	inline auto ChangesetEntry::Table() const -> std::string_view {
+		return this->m_pTable;
+	}
+
+	inline auto ChangesetEntry::Operation() const -> ChangesetOperation {
+		return static_cast<ChangesetOperation>(this->m_operation);
+	}
+
+	inline auto ChangesetEntry::ColumnCount() const -> int {
+		return this->m_columns;
+	}
+
+	inline auto ChangesetEntry::IsIndirect() const -> bool {
+		return (this->m_indirect != 0);
+	}
+
+	inline auto ChangesetEntry::Old(const int column) const -> sqlite3_value* {
+
+		sqlite3_value* pValue = nullptr;
+		const int res = sqlite3changeset_old(this->m_pIter, column, &pValue);
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+		return pValue;
+	}
+
+	inline auto ChangesetEntry::New(const int column) const -> sqlite3_value* {
+
+		sqlite3_value* pValue = nullptr;
+		const int res = sqlite3changeset_new(this->m_pIter, column, &pValue);
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+		return pValue;
+	}
+
+	inline auto ChangesetEntry::Conflict(const int column) const -> sqlite3_value* {
+
+		sqlite3_value* pValue = nullptr;
+		const int res = sqlite3changeset_conflict(this->m_pIter, column, &pValue);
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+		return pValue;
+	}
+
+	using ChangesetConflictHandler = std::function<ChangesetConflictAction(const ChangesetConflict conflict, const ChangesetEntry& entry)>;
+	using ChangesetTableFilter = std::function<bool(const std::string_view table)>;
+	using ChangesetInput = std::function<std::size_t(const std::span<std::uint8_t> buffer)>;
+	using ChangesetOutput = std::function<void(const std::span<const std::uint8_t> data)>;
+
+	class Session {
+
+	public:
+		Session(Database& db, const std::string_view schema = "main");
+
+		auto SessionHandle(void) const -> sqlite3_session*;
+
+		auto Attach(const std::optional<std::string_view> table = std::nullopt) -> void;
+		auto Enable(const bool enabled) -> void;
+		auto IsEmpty(void) const -> bool;
+
+		auto Changeset(void) const -> std::vector<std::uint8_t>;
+		auto Changeset(const ChangesetOutput& output) const -> void;
+		auto Patchset(void) const -> std::vector<std::uint8_t>;
+		auto Patchset(const ChangesetOutput& output) const -> void;
+
+		static auto Apply(Database& db, const std::span<const std::uint8_t> changeset, const ChangesetConflictHandler& onConflict = nullptr, const ChangesetTableFilter& filter = nullptr) -> void;
+		static auto Apply(Database& db, const ChangesetInput& input, const ChangesetConflictHandler& onConflict = nullptr, const ChangesetTableFilter& filter = nullptr) -> void;
+
+	private:
+		Handle<sqlite3_session*, nullptr> m_session;
+
+		struct Context {
+			const ChangesetConflictHandler* pOnConflict;
+			const ChangesetTableFilter* pFilter;
+			const ChangesetInput* pInput;
+			const ChangesetOutput* pOutput;
+			std::exception_ptr exception;
+		};
+
+		static auto Collect(int (*pfn)(sqlite3_session*, int*, void**), sqlite3_session* const pSession) -> std::vector<std::uint8_t>;
+		static auto Stream(int (*pfn)(sqlite3_session*, int (*)(void*, const void*, int), void*), sqlite3_session* const pSession, const ChangesetOutput& output) -> void;
+		static auto Check(const Context& ctx, const int res) -> void;
+
+		static auto OnFilter(void* pCtx, const char* zTable) -> int;
+		static auto OnConflict(void* pCtx, int conflict, sqlite3_changeset_iter* pIter) -> int;
+		static auto OnInput(void* pCtx, void* pData, int* pnData) -> int;
+		static auto OnOutput(void* pCtx, const void* pData, int nData) -> int;
+
+	};
+
+	inline Session::Session(Database& db, const std::string_view schema) {
+
+		const std::string schemaName { schema };
+
+		this->m_session = { nullptr, &sqlite3session_delete };
+
+		const int res = sqlite3session_create(db.ConnectionHandle(), schemaName.c_str(), this->m_session.GetAddressOf());
+		if (res != SQLITE_OK)
+			throw SqliteException { db.ConnectionHandle() };
+
+	}
+
+	inline auto Session::SessionHandle() const -> sqlite3_session* {
+		return this->m_session.Get();
+	}
+
+	inline auto Session::Attach(const std::optional<std::string_view> table) -> void {
+
+		const std::optional<std::string> tableName { table };
+
+		const int res = sqlite3session_attach(this->SessionHandle(), (tableName.has_value() ? tableName->c_str() : nullptr));
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline auto Session::Enable(const bool enabled) -> void {
+		sqlite3session_enable(this->SessionHandle(), (enabled ? 1 : 0));
+	}
+
+	inline auto Session::IsEmpty() const -> bool {
+		return (sqlite3session_isempty(this->SessionHandle()) != 0);
+	}
+
+	inline auto Session::Changeset() const -> std::vector<std::uint8_t> {
+		return Session::Collect(&sqlite3session_changeset, this->SessionHandle());
+	}
+
+	inline auto Session::Changeset(const ChangesetOutput& output) const -> void {
+		Session::Stream(&sqlite3session_changeset_strm, this->SessionHandle(), output);
+	}
+
+	inline auto Session::Patchset() const -> std::vector<std::uint8_t> {
+		return Session::Collect(&sqlite3session_patchset, this->SessionHandle());
+	}
+
+	inline auto Session::Patchset(const ChangesetOutput& output) const -> void {
+		Session::Stream(&sqlite3session_patchset_strm, this->SessionHandle(), output);
+	}
+
+	inline auto Session::Apply(Database& db, const std::span<const std::uint8_t> changeset, const ChangesetConflictHandler& onConflict, const ChangesetTableFilter& filter) -> void {
+
+		Context ctx = { &onConflict, &filter, nullptr, nullptr, nullptr };
+
+		const int res = sqlite3changeset_apply(
+			db.ConnectionHandle(),
+			static_cast<int>(changeset.size()),
+			const_cast<std::uint8_t*>(changeset.data()),
+			(filter ? &Session::OnFilter : nullptr),
+			&Session::OnConflict,
+			&ctx
+		);
+
+		Session::Check(ctx, res);
+
+	}
+
+	inline auto Session::Apply(Database& db, const ChangesetInput& input, const ChangesetConflictHandler& onConflict, const ChangesetTableFilter& filter) -> void {
+
+		Context ctx = { &onConflict, &filter, &input, nullptr, nullptr };
+
+		const int res = sqlite3changeset_apply_strm(
+			db.ConnectionHandle(),
+			&Session::OnInput,
+			&ctx,
+			(filter ? &Session::OnFilter : nullptr),
+			&Session::OnConflict,
+			&ctx
+		);
+
+		Session::Check(ctx, res);
+
+	}
+
+	inline auto Session::Collect(int (*pfn)(sqlite3_session*, int*, void**), sqlite3_session* const pSession) -> std::vector<std::uint8_t> {
+
+		int size = 0;
+		void* pData = nullptr;
+
+		const int res = pfn(pSession, &size, &pData);
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+		const Handle<std::uint8_t*, nullptr> data = { static_cast<std::uint8_t*>(pData), &sqlite3_free };
+
+		return { data.Get(), (data.Get() + size) };
+	}
+
+	inline auto Session::Stream(int (*pfn)(sqlite3_session*, int (*)(void*, const void*, int), void*), sqlite3_session* const pSession, const ChangesetOutput& output) -> void {
+
+		Context ctx = { nullptr, nullptr, nullptr, &output, nullptr };
+
+		const int res = pfn(pSession, &Session::OnOutput, &ctx);
+		if (ctx.exception) std::rethrow_exception(ctx.exception);
+
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline auto Session::Check(const Context& ctx, const int res) -> void {
+
+		if (ctx.exception) std::rethrow_exception(ctx.exception);
+
+		if (res != SQLITE_OK)
+			throw SqliteException { sqlite3_errstr(res), res };
+
+	}
+
+	inline auto Session::OnFilter(void* pCtx, const char* zTable) -> int {
+
+		Context* const pContext = static_cast<Context*>(pCtx);
+		if (pContext->exception) return 0;
+
+		try { return ((*pContext->pFilter)(zTable) ? 1 : 0); }
+		catch (...) { pContext->exception = std::current_exception(); }
+
+		return 0;
+	}
+
+	inline auto Session::OnConflict(void* pCtx, int conflict, sqlite3_changeset_iter* pIter) -> int {
+
+		Context* const pContext = static_cast<Context*>(pCtx);
+		if (pContext->exception || !(*pContext->pOnConflict)) return SQLITE_CHANGESET_ABORT;
+
+		try {
+			const ChangesetEntry entry = { pIter };
+			return static_cast<int>((*pContext->pOnConflict)(static_cast<ChangesetConflict>(conflict), entry));
+		}
+		catch (...) { pContext->exception = std::current_exception(); }
+
+		return SQLITE_CHANGESET_ABORT;
+	}
+
+	inline auto Session::OnInput(void* pCtx, void* pData, int* pnData) -> int {
+
+		Context* const pContext = static_cast<Context*>(pCtx);
+
+		try {
+			const std::span<std::uint8_t> buffer = { static_cast<std::uint8_t*>(pData), static_cast<std::size_t>(*pnData) };
+			*pnData = static_cast<int>((*pContext->pInput)(buffer));
+			return SQLITE_OK;
+		}
+		catch (...) { pContext->exception = std::current_exception(); }
+
+		return SQLITE_IOERR_READ;
+	}
+
+	inline auto Session::OnOutput(void* pCtx, const void* pData, int nData) -> int {
+
+		Context* const pContext = static_cast<Context*>(pCtx);
+
+		try {
+			(*pContext->pOutput)({ static_cast<const std::uint8_t*>(pData), static_cast<std::size_t>(nData) });
+			return SQLITE_OK;
+		}
+		catch (...) { pContext->exception = std::current_exception(); }
+
+		return SQLITE_IOERR_WRITE;
+	}
+
+#endif // SQLITE_ENABLE_SESSION && SQLITE_ENABLE_PREUPDATE_HOOK
+
 }
 
 #endif // __VSQLITE3_HPP__
\ No newline at end of file